@@ -5,50 +5,47 @@
 #include <algorithm>
 #include "global.h"
 #include "arch.h"
-
-Arch::~Arch() {
-  // Implementation of destructor
-  if (tileArray != nullptr) {
-    for (int i = 0; i < numCol; i++) {
-      for (int j = 0; j < numRow; j++) {
-        delete tileArray[i][j];
-      }
-      delete[] tileArray[i];
-    }
-    delete[] tileArray;
-  }
-
-  if (clockRegionArray != nullptr) {
-    for (int i = 0; i < numClockCol; i++) {
-      for (int j = 0; j < numClockRow; j++) {
-        delete clockRegionArray[i][j];
-      }
-      delete[] clockRegionArray[i];
-    }
-    delete[] clockRegionArray;
-  }
-}
+#include "fileio.h"
 
 void Arch::createTileArray(int numCol, int numRow) {
-  tileArray = new Tile**[numCol];
+  // one contiguous block, tiles are never added afterwards
+  tiles.clear();
+  tiles.reserve(numCol * numRow);
   for (int i = 0; i < numCol; i++) {
-    tileArray[i] = new Tile*[numRow];
     for (int j = 0; j < numRow; j++) {
-      tileArray[i][j] = new Tile(i, j);
+      tiles.emplace_back(i, j);
     }
   }
+  for (auto& typeTiles : tilesByType) {
+    typeTiles.clear();
+  }
 }
 
 void Arch::createClockRegionArray(int numCol, int numRow) {
-  clockRegionArray = new ClockRegion**[numCol];
-  for (int i = 0; i < numCol; i++) {
-    clockRegionArray[i] = new ClockRegion*[numRow];
-    for (int j = 0; j < numRow; j++) {
-      clockRegionArray[i][j] = new ClockRegion();
+  clockRegions.clear();
+  clockRegions.resize(numCol * numRow);
+}
+
+void Arch::indexTileTypes() {
+  for (int type = 0; type < NUM_TILE_TYPES; type++) {
+    tilesByType[type].clear();
+    for (unsigned int idx = 0; idx < tiles.size(); idx++) {
+      if (tiles[idx].hasType((TileType)type)) {
+        tilesByType[type].push_back(idx);
+      }
     }
   }
 }
 
+void Arch::createArrays(int numCol, int numRow, int numClockCol, int numClockRow) {
+  createTileArray(numCol, numRow);
+  setNumCol(numCol);
+  setNumRow(numRow);
+  createClockRegionArray(numClockCol, numClockRow);
+  setNumClockCol(numClockCol);
+  setNumClockRow(numClockRow);
+}
+
 // translate the coordinate of the instance to the coordinate of the clock region
 bool Arch::getClockRegionCoordinate(int instCol, int InstRow, int& clockCol, int& clockRow) {
   if (instCol < 0 || instCol >= numCol || InstRow < 0 || InstRow >= numRow) {
@@ -75,7 +72,7 @@ bool Arch::getClockRegionCoordinate(int instCol, int InstRow, int& clockCol, int
 
 bool Arch::readSclFile(std::string sclFileName) {
   // Implementation of readSclFile function
-  std::ifstream sclFile(sclFileName);
+  InputStream sclFile(sclFileName);
   if (!sclFile.is_open()) {
     std::cout << "Failed to open file: " << sclFileName << std::endl;
     return false;
@@ -132,11 +129,18 @@ bool Arch::readSclFile(std::string sclFileName) {
   for (int i = 0; i < numCol; i++) {
     for (int j = 0; j < numRow; j++) {
       Tile* tile = getTile(i, j);
-      if (tile->getNumTileTypes() == 0) {
-        tile->addType("UNDEFINED");
+      if (tile->getTileTypes() == 0) {
+        tile->addType(TILE_UNDEFINED);
       }
     }
   }
+  indexTileTypes();
+
+  if (sclFile.hasError()) {
+    std::cout << "Failed to read file: " << sclFileName << std::endl;
+    numErr++;
+  }
+  sclFile.reportBandwidth();
 
   if (numErr > 0) {
     return false;
@@ -147,7 +151,7 @@ bool Arch::readSclFile(std::string sclFileName) {
 
 bool Arch::readClkFile(std::string clkFileName) {
   // Implementation of readClkFile function
-  std::ifstream clkFile(clkFileName);
+  InputStream clkFile(clkFileName);
   if (!clkFile.is_open()) {
     std::cout << "Failed to open file: " << clkFileName << std::endl;
     return false;
@@ -197,6 +201,10 @@ bool Arch::readClkFile(std::string clkFileName) {
       return false;
     }
   }
+  if (clkFile.hasError()) {
+    std::cout << "Failed to read file: " << clkFileName << std::endl;
+    return false;
+  }
   return true;
 }
 
@@ -220,35 +228,31 @@ void Arch::cleanSlots() {
   // Implementation of cleanSlots function
   for (int i = 0; i < numCol; i++) {
     for (int j = 0; j < numRow; j++) {
-      //tileArray[i][j]->clearInstances();
+      //getTile(i, j)->clearInstances();
     }
   }
 }
 
+void Arch::clearDesign() {
+  for (Tile& tile : tiles) {
+    tile.clearInstances();
+  }
+  for (ClockRegion& clockRegion : clockRegions) {
+    clockRegion.clearClockNets();
+  }
+}
+
 void Arch::reportArch() {
   // Implementation of reportArch function
   std::cout << "  Number of columns: " << numCol << std::endl;
   std::cout << "  Number of rows: " << numRow << std::endl;
   std::cout << "  Number of clock regions: " << numClockCol * numClockRow << std::endl;   
 
-  std::map<std::string, int> tileCountByType;
-  for (int i = 0 ; i < numCol; i++) {
-    for (int j = 0; j < numRow; j++) {
-      Tile* tile = getTile(i, j);
-      std::set<std::string> tileTypes = tile->getTileTypes();
-      for (const std::string& type : tileTypes) {
-        if (tileCountByType.find(type) == tileCountByType.end()) {
-          tileCountByType[type] = 1;
-        } else {
-          tileCountByType[type]++;
-        }            
-      }
-    }
-  }
-
   std::multimap<int, std::string> sortedTileCount;
-  for (const auto& pair : tileCountByType) {
-    sortedTileCount.insert(std::make_pair(pair.second, pair.first));
+  for (int type = 0; type < NUM_TILE_TYPES; type++) {
+    if (!tilesByType[type].empty()) {
+      sortedTileCount.insert(std::make_pair((int)tilesByType[type].size(), std::string(tileTypeNames[type])));
+    }
   }
 
   std::cout << std::endl;
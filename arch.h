@@ -8,17 +8,18 @@ class Arch {
     int numRow;
     int numClockCol;
     int numClockRow;
-    Tile*** tileArray;
-    ClockRegion ***clockRegionArray;
+    std::vector<Tile> tiles;                 // tile (col, row) at col * numRow + row
+    std::vector<ClockRegion> clockRegions;   // clock region (col, row) at col * numClockRow + row
+    std::vector<int> tilesByType[NUM_TILE_TYPES];   // ascending tile indices of each tile type
 
 public:
     // Constructor
-    Arch() : numCol(0), numRow(0), numClockCol(0), numClockRow(0), tileArray(nullptr), clockRegionArray(nullptr) {
+    Arch() : numCol(0), numRow(0), numClockCol(0), numClockRow(0) {
         // Add your constructor code here
     }
 
     // Destructor
-    ~Arch(); 
+    ~Arch() {}
 
     // Getter and setter for all data members
     int getNumCol() const { return numCol; }
@@ -31,17 +32,30 @@ public:
     void setNumClockCol(int value) { numClockCol = value; }
     void setNumClockRow(int value) { numClockRow = value;}
 
+    int getTileIndex(int col, int row) const { return col * numRow + row; }
+    // nullptr outside the chip
     Tile* getTile(int col, int row) {
-        return tileArray[col][row];
+        if (col < 0 || col >= numCol || row < 0 || row >= numRow) {
+            return nullptr;
+        }
+        return &tiles[getTileIndex(col, row)];
     }
     ClockRegion* getClockRegion(int col, int row) {
-        return clockRegionArray[col][row];
+        return &clockRegions[col * numClockRow + row];
     }
 
+    // tiles in memory order, the same order as a column by column scan
+    int getNumTiles() const { return tiles.size(); }
+    Tile* getTileByIndex(int idx) { return &tiles[idx]; }
+    const std::vector<int>& getTilesOfType(TileType tileType) const { return tilesByType[tileType]; }
+    void indexTileTypes();  // rebuild the tile lists once the tile types are set
+
     bool readArch(std::string sclFileName, std::string clkFileName);
+    void createArrays(int numCol, int numRow, int numClockCol, int numClockRow);  // for the arch snapshot loader
     void reportArch();
 
     void cleanSlots();  // to load placement result 
+    void clearDesign();  // drop the instances and clock nets of the loaded design
 
     bool getClockRegionCoordinate(int instCol, int InstRow, int& clockCol, int& clockRow);
 
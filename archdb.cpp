@@ -0,0 +1,352 @@
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cstdint>
+#include "archdb.h"
+#include "global.h"
+#include "fileio.h"
+
+// File layout, native byte order:
+//   ArchDBHeader
+//   string table       '\0' separated: tile and slot type names, then for each lib
+//                      the lib name followed by its input and output pin names
+//   ArchDBLib          [numLibs]
+//   pin props          uint8_t [numLibPins], inputs then outputs of each lib
+//   slot layout        ArchDBSlots [numSlotGroups], per tile type
+//   tile type masks    uint32_t [numCol * numRow], bit i is type i, column major
+//   clock regions      int32_t [numClockCol * numClockRow * 4], left right bottom top
+#define ARCH_DB_MAGIC 0x52413854   // "T8AR"
+#define ARCH_DB_VERSION 1
+#define ARCH_DB_MAX_TYPES 32
+
+struct ArchDBHeader {
+  uint32_t magic;
+  uint32_t version;
+  int32_t numCol;
+  int32_t numRow;
+  int32_t numClockCol;
+  int32_t numClockRow;
+  uint32_t numTypes;       // tile types
+  uint32_t numTypeNames;   // tile types followed by slot types
+  uint32_t numLibs;
+  uint32_t numLibPins;
+  uint32_t numSlotGroups;
+  uint32_t stringBytes;
+};
+
+struct ArchDBLib {
+  int32_t numInputs;
+  int32_t numOutputs;
+};
+
+// slots a tile of a given type allocates for one slot type
+struct ArchDBSlots {
+  int32_t tileType;
+  int32_t slotType;     // index in the type name table
+  int32_t capacity;
+};
+
+static int findOrAddName(std::vector<std::string>& names, const std::string& name) {
+  for (unsigned int i = 0; i < names.size(); i++) {
+    if (names[i] == name) {
+      return i;
+    }
+  }
+  names.push_back(name);
+  return names.size() - 1;
+}
+
+// slot layout of a freshly initialized tile of each type
+static void collectSlotLayout(std::vector<std::string>& typeNames, std::vector<ArchDBSlots>& slotGroups) {
+  slotGroups.clear();
+  unsigned int numTileTypes = typeNames.size();
+  for (unsigned int t = 0; t < numTileTypes; t++) {
+    if (typeNames[t] == "UNDEFINED") {
+      continue;
+    }
+    Tile tile(0, 0);
+    tile.initTile(typeNames[t]);
+    for (int kind = 0; kind < NUM_SLOT_KINDS; kind++) {
+      if (!tile.hasSlots((SlotKind)kind)) {
+        continue;
+      }
+      ArchDBSlots group;
+      group.tileType = t;
+      group.slotType = findOrAddName(typeNames, slotKindNames[kind]);
+      group.capacity = slotCapacity[kind];
+      slotGroups.push_back(group);
+    }
+  }
+}
+
+static bool isSameSlotLayout(
+  const std::vector<std::string>& typeNames,
+  const std::vector<std::string>& strings,
+  const std::vector<ArchDBSlots>& slotGroups) {
+
+  std::vector<std::string> names(typeNames);
+  std::vector<ArchDBSlots> expectedGroups;
+  collectSlotLayout(names, expectedGroups);
+  if (expectedGroups.size() != slotGroups.size()) {
+    return false;
+  }
+  for (unsigned int i = 0; i < slotGroups.size(); i++) {
+    const ArchDBSlots& group = slotGroups[i];
+    if (group.slotType < 0 || group.slotType >= (int)strings.size()) {
+      return false;
+    }
+    if (expectedGroups[i].tileType != group.tileType ||
+        names[expectedGroups[i].slotType] != strings[group.slotType] ||
+        expectedGroups[i].capacity != group.capacity) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool writeArchDB(const std::string& fileName) {
+  if (chip.getNumCol() == 0 || glbLibMap.empty()) {
+    std::cout << "Architecture is not loaded" << std::endl;
+    return false;
+  }
+  std::ofstream outFile(fileName, std::ios::binary);
+  if (!outFile.is_open()) {
+    std::cout << "Failed to open file: " << fileName << std::endl;
+    return false;
+  }
+
+  // tile type grid
+  std::vector<std::string> typeNames;
+  std::vector<uint32_t> tileMasks;
+  tileMasks.reserve(chip.getNumCol() * chip.getNumRow());
+  for (int i = 0; i < chip.getNumCol(); i++) {
+    for (int j = 0; j < chip.getNumRow(); j++) {
+      uint32_t mask = 0;
+      Tile* tile = chip.getTile(i, j);
+      for (int type = 0; type < NUM_TILE_TYPES; type++) {
+        if (!tile->hasType((TileType)type)) {
+          continue;
+        }
+        int typeIdx = findOrAddName(typeNames, tileTypeNames[type]);
+        if (typeIdx >= ARCH_DB_MAX_TYPES) {
+          std::cout << "Too many tile types for the architecture database" << std::endl;
+          return false;
+        }
+        mask |= 1u << typeIdx;
+      }
+      tileMasks.push_back(mask);
+    }
+  }
+  unsigned int numTypes = typeNames.size();
+
+  // slot layout, slot type names are appended to the name table
+  std::vector<ArchDBSlots> slotGroups;
+  collectSlotLayout(typeNames, slotGroups);
+
+  // clock regions
+  std::vector<int32_t> clockBoxes;
+  for (int i = 0; i < chip.getNumClockCol(); i++) {
+    for (int j = 0; j < chip.getNumClockRow(); j++) {
+      ClockRegion* clockRegion = chip.getClockRegion(i, j);
+      clockBoxes.push_back(clockRegion->getXLeft());
+      clockBoxes.push_back(clockRegion->getXRight());
+      clockBoxes.push_back(clockRegion->getYBottom());
+      clockBoxes.push_back(clockRegion->getYTop());
+    }
+  }
+
+  // lib pin tables
+  std::string stringTable;
+  for (const std::string& name : typeNames) {
+    stringTable += name;
+    stringTable += '\0';
+  }
+  std::vector<ArchDBLib> libs;
+  std::vector<uint8_t> pinProps;
+  for (const auto& pair : glbLibMap) {
+    Lib* lib = pair.second;
+    ArchDBLib rec;
+    rec.numInputs = lib->getNumInputs();
+    rec.numOutputs = lib->getNumOutputs();
+    libs.push_back(rec);
+    stringTable += lib->getName();
+    stringTable += '\0';
+    for (const auto& pin : lib->getInputs()) {
+      stringTable += pin.first;
+      stringTable += '\0';
+      pinProps.push_back(pin.second);
+    }
+    for (const auto& pin : lib->getOutputs()) {
+      stringTable += pin.first;
+      stringTable += '\0';
+      pinProps.push_back(pin.second);
+    }
+  }
+
+  ArchDBHeader header;
+  header.magic = ARCH_DB_MAGIC;
+  header.version = ARCH_DB_VERSION;
+  header.numCol = chip.getNumCol();
+  header.numRow = chip.getNumRow();
+  header.numClockCol = chip.getNumClockCol();
+  header.numClockRow = chip.getNumClockRow();
+  header.numTypes = numTypes;
+  header.numTypeNames = typeNames.size();
+  header.numLibs = libs.size();
+  header.numLibPins = pinProps.size();
+  header.numSlotGroups = slotGroups.size();
+  header.stringBytes = stringTable.size();
+
+  outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  outFile.write(stringTable.data(), stringTable.size());
+  writeArray(outFile, libs);
+  writeArray(outFile, pinProps);
+  writeArray(outFile, slotGroups);
+  writeArray(outFile, tileMasks);
+  writeArray(outFile, clockBoxes);
+  outFile.close();
+  if (!outFile) {
+    std::cout << "Failed to write file: " << fileName << std::endl;
+    return false;
+  }
+
+  std::cout << "  Wrote " << numTypes << " tile types, " << tileMasks.size() << " tiles and "
+            << libs.size() << " libraries to " << fileName << std::endl;
+  return true;
+}
+
+bool readArchDB(const std::string& fileName) {
+  if (glbLibMap.empty() == false || chip.getNumCol() != 0) {
+    std::cout << "Architecture is already loaded" << std::endl;
+    return false;
+  }
+
+  InputFile inputFile;
+  if (!inputFile.open(fileName)) {
+    std::cout << "Failed to open file: " << fileName << std::endl;
+    return false;
+  }
+  auto startTime = std::chrono::steady_clock::now();
+
+  const char* cursor = inputFile.begin();
+  const char* end = inputFile.end();
+  ArchDBHeader header;
+  if (inputFile.getSize() < sizeof(header)) {
+    std::cout << "Invalid architecture database: " << fileName << std::endl;
+    return false;
+  }
+  std::memcpy(&header, cursor, sizeof(header));
+  cursor += sizeof(header);
+  if (header.magic != ARCH_DB_MAGIC) {
+    std::cout << "Invalid architecture database: " << fileName << std::endl;
+    return false;
+  }
+  if (header.version != ARCH_DB_VERSION) {
+    std::cout << "Unsupported architecture database version " << header.version << ", expected " << ARCH_DB_VERSION << std::endl;
+    return false;
+  }
+  if (header.numCol <= 0 || header.numRow <= 0 || header.numClockCol < 0 || header.numClockRow < 0) {
+    std::cout << "Invalid architecture database: " << fileName << std::endl;
+    return false;
+  }
+
+  std::vector<char> stringTable;
+  std::vector<ArchDBLib> libs;
+  std::vector<uint8_t> pinProps;
+  std::vector<ArchDBSlots> slotGroups;
+  std::vector<uint32_t> tileMasks;
+  std::vector<int32_t> clockBoxes;
+  if (!readArray(cursor, end, header.stringBytes, stringTable) ||
+      !readArray(cursor, end, header.numLibs, libs) ||
+      !readArray(cursor, end, header.numLibPins, pinProps) ||
+      !readArray(cursor, end, header.numSlotGroups, slotGroups) ||
+      !readArray(cursor, end, (size_t)header.numCol * header.numRow, tileMasks) ||
+      !readArray(cursor, end, (size_t)header.numClockCol * header.numClockRow * 4, clockBoxes)) {
+    std::cout << "Truncated architecture database: " << fileName << std::endl;
+    return false;
+  }
+
+  // split the string table
+  std::vector<std::string> strings;
+  size_t strBegin = 0;
+  for (size_t i = 0; i < stringTable.size(); i++) {
+    if (stringTable[i] == '\0') {
+      strings.push_back(std::string(stringTable.data() + strBegin, i - strBegin));
+      strBegin = i + 1;
+    }
+  }
+  if (header.numTypes > ARCH_DB_MAX_TYPES || header.numTypes > header.numTypeNames ||
+      strings.size() != header.numTypeNames + header.numLibs + header.numLibPins) {
+    std::cout << "Invalid architecture database: " << fileName << std::endl;
+    return false;
+  }
+  std::vector<std::string> typeNames(strings.begin(), strings.begin() + header.numTypes);
+
+  // the slot layout has to match the one of this build
+  if (!isSameSlotLayout(typeNames, strings, slotGroups)) {
+    std::cout << "Slot layout of " << fileName << " does not match this checker, re-create it with write_arch_db" << std::endl;
+    return false;
+  }
+
+  // pin properties index the lib pin tables
+  for (uint8_t prop : pinProps) {
+    if (prop >= NUM_PIN_PROPS) {
+      std::cout << "Invalid architecture database: " << fileName << std::endl;
+      return false;
+    }
+  }
+
+  // libraries
+  unsigned int strIdx = header.numTypeNames;
+  unsigned int pinIdx = 0;
+  for (const ArchDBLib& rec : libs) {
+    if (rec.numInputs < 0 || rec.numOutputs < 0 || pinIdx + rec.numInputs + rec.numOutputs > pinProps.size()) {
+      std::cout << "Invalid architecture database: " << fileName << std::endl;
+      return false;
+    }
+    Lib* newLib = glbLibArena.create(strings[strIdx++]);
+    newLib->setNumInputs(rec.numInputs);
+    newLib->setNumOutputs(rec.numOutputs);
+    for (int i = 0; i < rec.numInputs; i++) {
+      newLib->setInput(i, strings[strIdx++], (PinProp)pinProps[pinIdx++]);
+    }
+    for (int i = 0; i < rec.numOutputs; i++) {
+      newLib->setOutput(i, strings[strIdx++], (PinProp)pinProps[pinIdx++]);
+    }
+    newLib->buildPinTables();
+    glbLibMap[newLib->getName()] = newLib;
+  }
+
+  // tiles and clock regions
+  chip.createArrays(header.numCol, header.numRow, header.numClockCol, header.numClockRow);
+  unsigned int tileIdx = 0;
+  for (int i = 0; i < header.numCol; i++) {
+    for (int j = 0; j < header.numRow; j++) {
+      Tile* tile = chip.getTile(i, j);
+      uint32_t mask = tileMasks[tileIdx++];
+      for (unsigned int t = 0; t < typeNames.size(); t++) {
+        if (mask & (1u << t)) {
+          if (typeNames[t] == "UNDEFINED") {
+            tile->addType(TILE_UNDEFINED);
+          } else {
+            tile->initTile(typeNames[t]);
+          }
+        }
+      }
+    }
+  }
+  chip.indexTileTypes();
+  unsigned int boxIdx = 0;
+  for (int i = 0; i < header.numClockCol; i++) {
+    for (int j = 0; j < header.numClockRow; j++) {
+      const int32_t* box = &clockBoxes[boxIdx];
+      chip.getClockRegion(i, j)->setBoundingBox(box[0], box[1], box[2], box[3]);
+      boxIdx += 4;
+    }
+  }
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+  reportThroughput(fileName, inputFile.getSize(), elapsed.count());
+  inputFile.reportBandwidth();
+  return true;
+}
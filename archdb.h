@@ -0,0 +1,8 @@
+#pragma once
+
+#include <string>
+
+// binary image of the device read by read_arch:
+// lib pin tables, tile type grid, slot layout and clock region bounding boxes
+bool writeArchDB(const std::string& fileName);
+bool readArchDB(const std::string& fileName);
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <vector>
+#include <new>
+#include <utility>
+#include <cstddef>
+#include <type_traits>
+
+#define ARENA_BLOCK_SIZE 4096   // objects per block
+
+// owner of objects created in blocks and released in bulk
+// objects are never freed one by one; clear() destroys all of them and returns the
+// blocks, which is a handful of frees for trivially destructible types.
+// not thread-safe: concurrent producers fill arenas of their own and splice them
+// into the shared one afterwards
+template <typename T>
+class ObjectArena {
+    struct Block {
+        T* objects;
+        size_t used;
+    };
+    std::vector<Block> blocks;
+    size_t numObjects;
+
+public:
+    ObjectArena() : numObjects(0) {}
+    ObjectArena(ObjectArena&& other) : blocks(std::move(other.blocks)), numObjects(other.numObjects) {
+        other.blocks.clear();
+        other.numObjects = 0;
+    }
+    ~ObjectArena() { clear(); }
+
+    template <typename... Args>
+    T* create(Args&&... args) {
+        if (blocks.empty() || blocks.back().used == ARENA_BLOCK_SIZE) {
+            Block block;
+            block.objects = static_cast<T*>(::operator new(sizeof(T) * ARENA_BLOCK_SIZE));
+            block.used = 0;
+            blocks.push_back(block);
+        }
+        Block& block = blocks.back();
+        T* obj = new (block.objects + block.used) T(std::forward<Args>(args)...);
+        block.used++;
+        numObjects++;
+        return obj;
+    }
+
+    // take over all objects of other, which is left empty
+    void splice(ObjectArena& other) {
+        if (other.blocks.empty()) {
+            return;
+        }
+        // the partly used last block of this arena is not filled any further
+        blocks.insert(blocks.end(), other.blocks.begin(), other.blocks.end());
+        numObjects += other.numObjects;
+        other.blocks.clear();
+        other.numObjects = 0;
+    }
+
+    size_t size() const { return numObjects; }
+
+    void clear() {
+        for (Block& block : blocks) {
+            if (!std::is_trivially_destructible<T>::value) {
+                for (size_t i = 0; i < block.used; i++) {
+                    block.objects[i].~T();
+                }
+            }
+            ::operator delete(block.objects);
+        }
+        blocks.clear();
+        numObjects = 0;
+    }
+
+private:
+    ObjectArena(const ObjectArena&);
+    ObjectArena& operator=(const ObjectArena&);
+};
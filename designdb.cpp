@@ -0,0 +1,383 @@
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <algorithm>
+#include "designdb.h"
+#include "global.h"
+#include "fileio.h"
+#include "netlist.h"
+
+// File layout, all sections are packed arrays in native byte order:
+//   DesignDBHeader
+//   lib names          '\0' separated, libNameBytes in total
+//   DBInstance         [numInsts]
+//   pin net IDs        int32_t [numPins], inputs then outputs of each instance
+//   pin critical flags uint8_t [numPins]
+//   DBNet              [numNets]
+//   net sink pins      int32_t [numSinks], global pin indices
+#define DESIGN_DB_MAGIC 0x42443854   // "T8DB"
+#define DESIGN_DB_VERSION 1
+
+struct DesignDBHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t numLibs;
+  uint32_t libNameBytes;
+  uint32_t numInsts;
+  uint32_t numPins;
+  uint32_t numNets;
+  uint32_t numSinks;
+};
+
+struct DBInstance {
+  int32_t id;
+  int32_t lib;        // index into the lib name table
+  int32_t x;
+  int32_t y;
+  int32_t z;
+  int32_t fixed;
+  int32_t pinBegin;   // first global pin index
+};
+
+struct DBNet {
+  int32_t id;
+  int32_t clock;
+  int32_t driver;     // global pin index, -1 if undriven
+  int32_t sinkBegin;
+  int32_t numSinks;
+};
+
+// objects of a table in the order of their external IDs, the order of a fresh read
+template <typename T>
+static std::vector<T*> byExternalID(const IdTable<T>& table, const IdRenumbering& ids) {
+  std::vector<T*> objects;
+  objects.reserve(table.size());
+  for (const auto& pair : table) {
+    objects.push_back(pair.second);
+  }
+  if (!ids.isIdentity()) {
+    std::sort(objects.begin(), objects.end(), [&ids](const T* a, const T* b) {
+      return ids.toExternal(a->getId()) < ids.toExternal(b->getId());
+    });
+  }
+  return objects;
+}
+
+static int32_t externalNetID(int netID) {
+  return netID >= 0 ? glbNetIDs.toExternal(netID) : netID;
+}
+
+bool writeDesignDB(const std::string& fileName) {
+  std::ofstream outFile(fileName, std::ios::binary);
+  if (!outFile.is_open()) {
+    std::cout << "Failed to open file: " << fileName << std::endl;
+    return false;
+  }
+
+  std::vector<std::string> libNames;
+  std::unordered_map<const Lib*, int> libIndex;
+  std::string libNameBlob;
+  for (const auto& pair : glbLibMap) {
+    libIndex[pair.second] = libNames.size();
+    libNames.push_back(pair.first);
+    libNameBlob += pair.first;
+    libNameBlob += '\0';
+  }
+
+  std::vector<DBInstance> insts;
+  std::vector<int32_t> pinNets;
+  std::vector<uint8_t> pinCrits;
+  std::vector<int32_t> pinIndex(glbPinStore.size(), -1);   // glbPinStore index -> database pin index
+  insts.reserve(glbInstMap.size());
+  for (Instance* inst : byExternalID(glbInstMap, glbInstIDs)) {
+    DBInstance rec;
+    rec.id = glbInstIDs.toExternal(inst->getId());
+    rec.lib = libIndex.at(inst->getCellLib());
+    rec.x = glbBaselinePlacement.getX(inst->getId());
+    rec.y = glbBaselinePlacement.getY(inst->getId());
+    rec.z = glbBaselinePlacement.getZ(inst->getId());
+    rec.fixed = inst->isFixed();
+    rec.pinBegin = pinNets.size();
+    insts.push_back(rec);
+    for (int i = 0; i < inst->getNumInpins(); i++) {
+      Pin pin = inst->getInpin(i);
+      pinIndex[pin.getIndex()] = pinNets.size();
+      pinNets.push_back(externalNetID(pin.getNetID()));
+      pinCrits.push_back(pin.getTimingCritical());
+    }
+    for (int i = 0; i < inst->getNumOutpins(); i++) {
+      Pin pin = inst->getOutpin(i);
+      pinIndex[pin.getIndex()] = pinNets.size();
+      pinNets.push_back(externalNetID(pin.getNetID()));
+      pinCrits.push_back(pin.getTimingCritical());
+    }
+  }
+
+  std::vector<DBNet> nets;
+  std::vector<int32_t> sinks;
+  nets.reserve(glbNetMap.size());
+  for (Net* net : byExternalID(glbNetMap, glbNetIDs)) {
+    DBNet rec;
+    rec.id = glbNetIDs.toExternal(net->getId());
+    rec.clock = net->isClock();
+    rec.driver = net->getInpin().isValid() ? pinIndex[net->getInpin().getIndex()] : -1;
+    rec.sinkBegin = sinks.size();
+    for (const Pin& pin : net->getOutputPins()) {
+      sinks.push_back(pinIndex[pin.getIndex()]);
+    }
+    rec.numSinks = sinks.size() - rec.sinkBegin;
+    nets.push_back(rec);
+  }
+
+  DesignDBHeader header;
+  header.magic = DESIGN_DB_MAGIC;
+  header.version = DESIGN_DB_VERSION;
+  header.numLibs = libNames.size();
+  header.libNameBytes = libNameBlob.size();
+  header.numInsts = insts.size();
+  header.numPins = pinNets.size();
+  header.numNets = nets.size();
+  header.numSinks = sinks.size();
+
+  outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  outFile.write(libNameBlob.data(), libNameBlob.size());
+  writeArray(outFile, insts);
+  writeArray(outFile, pinNets);
+  writeArray(outFile, pinCrits);
+  writeArray(outFile, nets);
+  writeArray(outFile, sinks);
+  outFile.close();
+  if (!outFile) {
+    std::cout << "Failed to write file: " << fileName << std::endl;
+    return false;
+  }
+
+  std::cout << "  Wrote " << insts.size() << " instances, " << pinNets.size() << " pins and "
+            << nets.size() << " nets to " << fileName << std::endl;
+  return true;
+}
+
+// check the records against each other and the arch before any object is
+// created, so that a bad database leaves the design empty
+static bool checkRecords(const std::string& fileName, const std::vector<Lib*>& libs,
+                         const std::vector<DBInstance>& insts, const std::vector<int32_t>& pinNets,
+                         const std::vector<DBNet>& nets, const std::vector<int32_t>& sinks) {
+  int numPins = pinNets.size();
+  // the pin ranges of the instances cover the pins from the first one on
+  if (insts.empty() ? numPins != 0 : insts[0].pinBegin != 0) {
+    std::cout << "Invalid design database: " << fileName << std::endl;
+    return false;
+  }
+  std::vector<bool> isInstID;
+  for (unsigned int i = 0; i < insts.size(); i++) {
+    const DBInstance& rec = insts[i];
+    int pinEnd = (i + 1 < insts.size()) ? insts[i + 1].pinBegin : numPins;
+    if (rec.id < 0 || rec.lib < 0 || rec.lib >= (int)libs.size() ||
+        rec.pinBegin < 0 || rec.pinBegin > pinEnd || pinEnd > numPins ||
+        rec.x < 0 || rec.x >= chip.getNumCol() || rec.y < 0 || rec.y >= chip.getNumRow() || rec.z < 0) {
+      std::cout << "Invalid design database: " << fileName << std::endl;
+      return false;
+    }
+    if (rec.id > MAX_OBJECT_ID) {
+      std::cout << "Error: ID of instance inst_" << rec.id << " is larger than " << MAX_OBJECT_ID << std::endl;
+      return false;
+    }
+    if ((size_t)rec.id >= isInstID.size()) {
+      isInstID.resize(rec.id + 1, false);
+    }
+    if (isInstID[rec.id]) {
+      std::cout << "Invalid design database: " << fileName << std::endl;
+      return false;
+    }
+    isInstID[rec.id] = true;
+    const Lib* libPtr = libs[rec.lib];
+    if (pinEnd - rec.pinBegin != libPtr->getNumInputs() + libPtr->getNumOutputs()) {
+      std::cout << "Error: Pin count of instance inst_" << rec.id << " does not match library " << libPtr->getName() << std::endl;
+      return false;
+    }
+  }
+
+  // a connected pin is listed as driver or sink by the net it is on; as in
+  // the .nets reader, other nets may list it too
+  std::vector<bool> isNetID;
+  std::vector<bool> isListed(numPins, false);
+  auto listPin = [&](int pinIdx, int netID) {
+    if (pinIdx < 0 || pinIdx >= numPins) {
+      return false;
+    }
+    if (pinNets[pinIdx] == netID) {
+      isListed[pinIdx] = true;
+    }
+    return true;
+  };
+  for (const DBNet& rec : nets) {
+    if (rec.id < 0 || rec.driver < -1 || rec.driver >= numPins ||
+        rec.sinkBegin < 0 || rec.numSinks < 0 || (int64_t)rec.sinkBegin + rec.numSinks > (int64_t)sinks.size()) {
+      std::cout << "Invalid design database: " << fileName << std::endl;
+      return false;
+    }
+    if (rec.id > MAX_OBJECT_ID) {
+      std::cout << "Error: ID of net net_" << rec.id << " is larger than " << MAX_OBJECT_ID << std::endl;
+      return false;
+    }
+    if ((size_t)rec.id >= isNetID.size()) {
+      isNetID.resize(rec.id + 1, false);
+    }
+    if (isNetID[rec.id]) {
+      std::cout << "Invalid design database: " << fileName << std::endl;
+      return false;
+    }
+    isNetID[rec.id] = true;
+    if (rec.driver != -1 && !listPin(rec.driver, rec.id)) {
+      std::cout << "Invalid design database: " << fileName << std::endl;
+      return false;
+    }
+    for (int i = rec.sinkBegin; i < rec.sinkBegin + rec.numSinks; i++) {
+      if (!listPin(sinks[i], rec.id)) {
+        std::cout << "Invalid design database: " << fileName << std::endl;
+        return false;
+      }
+    }
+  }
+
+  // pins are unconnected or listed by their net
+  for (int pinIdx = 0; pinIdx < numPins; pinIdx++) {
+    if (!isListed[pinIdx] && pinNets[pinIdx] != -1) {
+      std::cout << "Invalid design database: " << fileName << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool readDesignDB(const std::string& fileName) {
+  if (glbInstMap.empty() == false || glbNetMap.empty() == false) {
+    std::cout << "Design is not empty" << std::endl;
+    return false;
+  }
+
+  InputFile inputFile;
+  if (!inputFile.open(fileName)) {
+    std::cout << "Failed to open file: " << fileName << std::endl;
+    return false;
+  }
+  auto startTime = std::chrono::steady_clock::now();
+
+  const char* cursor = inputFile.begin();
+  const char* end = inputFile.end();
+  DesignDBHeader header;
+  if (inputFile.getSize() < sizeof(header)) {
+    std::cout << "Invalid design database: " << fileName << std::endl;
+    return false;
+  }
+  std::memcpy(&header, cursor, sizeof(header));
+  cursor += sizeof(header);
+  if (header.magic != DESIGN_DB_MAGIC) {
+    std::cout << "Invalid design database: " << fileName << std::endl;
+    return false;
+  }
+  if (header.version != DESIGN_DB_VERSION) {
+    std::cout << "Unsupported design database version " << header.version << ", expected " << DESIGN_DB_VERSION << std::endl;
+    return false;
+  }
+
+  std::vector<char> libNameBlob;
+  std::vector<DBInstance> insts;
+  std::vector<int32_t> pinNets;
+  std::vector<uint8_t> pinCrits;
+  std::vector<DBNet> nets;
+  std::vector<int32_t> sinks;
+  if (!readArray(cursor, end, header.libNameBytes, libNameBlob) ||
+      !readArray(cursor, end, header.numInsts, insts) ||
+      !readArray(cursor, end, header.numPins, pinNets) ||
+      !readArray(cursor, end, header.numPins, pinCrits) ||
+      !readArray(cursor, end, header.numNets, nets) ||
+      !readArray(cursor, end, header.numSinks, sinks)) {
+    std::cout << "Truncated design database: " << fileName << std::endl;
+    return false;
+  }
+
+  // bind lib names to the library read by read_arch
+  std::vector<Lib*> libs;
+  size_t nameBegin = 0;
+  for (size_t i = 0; i < libNameBlob.size(); i++) {
+    if (libNameBlob[i] != '\0') {
+      continue;
+    }
+    std::string libName(libNameBlob.data() + nameBegin, i - nameBegin);
+    auto libIt = glbLibMap.find(libName);
+    if (libIt == glbLibMap.end()) {
+      std::cout << "Error: Library with name " << libName << " not found." << std::endl;
+      return false;
+    }
+    libs.push_back(libIt->second);
+    nameBegin = i + 1;
+  }
+  if (libs.size() != header.numLibs) {
+    std::cout << "Invalid design database: " << fileName << std::endl;
+    return false;
+  }
+  if (!checkRecords(fileName, libs, insts, pinNets, nets, sinks)) {
+    return false;
+  }
+
+  // clear all baseline instances in all tiles
+  for (int tileIdx = 0; tileIdx < chip.getNumTiles(); tileIdx++) {
+    chip.getTileByIndex(tileIdx)->clearInstances();
+  }
+
+  std::vector<Pin> pins(header.numPins);
+  for (unsigned int i = 0; i < insts.size(); i++) {
+    const DBInstance& rec = insts[i];
+    Lib* libPtr = libs[rec.lib];
+    int pinEnd = (i + 1 < insts.size()) ? insts[i + 1].pinBegin : (int)header.numPins;
+
+    Instance* newInstance = glbInstArena.create(rec.id);
+    newInstance->setBaseLocation(std::make_tuple(rec.x, rec.y, rec.z));
+    newInstance->setFixed(rec.fixed != 0);
+    newInstance->setCellLib(libPtr);
+    glbInstMap[rec.id] = newInstance;
+
+    int pinIdx = rec.pinBegin;
+    for (int j = 0; j < newInstance->getNumInpins(); j++, pinIdx++) {
+      pins[pinIdx] = newInstance->getInpin(j);
+    }
+    for (int j = 0; j < newInstance->getNumOutpins(); j++, pinIdx++) {
+      pins[pinIdx] = newInstance->getOutpin(j);
+    }
+    for (pinIdx = rec.pinBegin; pinIdx < pinEnd; pinIdx++) {
+      pins[pinIdx].setNetID(pinNets[pinIdx]);
+      pins[pinIdx].setTimingCritical(pinCrits[pinIdx] != 0);
+    }
+
+    Tile* tilePtr = chip.getTile(rec.x, rec.y);
+    if (tilePtr->addInstance(rec.id, rec.z, libPtr, true) == false) {
+      std::cout << "Error: Failed to add baseline coordinate for instance inst_" << rec.id << std::endl;
+      resetDesign();
+      return false;
+    }
+  }
+
+  glbNetSinks.reserve(nets.size(), sinks.size());
+  std::vector<Pin> netSinks;
+  for (const DBNet& rec : nets) {
+    Net* newNet = glbNetArena.create(rec.id);
+    newNet->setClock(rec.clock != 0);
+    if (rec.driver >= 0) {
+      newNet->setInpin(pins[rec.driver]);
+    }
+    netSinks.clear();
+    for (int i = rec.sinkBegin; i < rec.sinkBegin + rec.numSinks; i++) {
+      netSinks.push_back(pins[sinks[i]]);
+    }
+    newNet->setSinkRow(glbNetSinks.addRow(netSinks.data(), netSinks.data() + netSinks.size()));
+    glbNetMap[rec.id] = newNet;
+  }
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+  reportThroughput(fileName, inputFile.getSize(), elapsed.count());
+  inputFile.reportBandwidth();
+  return true;
+}
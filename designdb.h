@@ -0,0 +1,10 @@
+#pragma once
+
+#include <string>
+
+// binary snapshot of everything read_design builds:
+// instances with lib binding and baseline placement, pins with net and
+// timing-critical flags, and net connectivity.
+// read_arch has to be done before reading a snapshot back.
+bool writeDesignDB(const std::string& fileName);
+bool readDesignDB(const std::string& fileName);
@@ -0,0 +1,331 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <zlib.h>
+#include "fileio.h"
+
+#define GZIP_MAX_RATIO 1032      // deflate expands data at most this many times
+
+static double secondsSince(const std::chrono::steady_clock::time_point& startTime) {
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+  return elapsed.count();
+}
+
+// read count bytes at offset, retrying short reads; false on error or early EOF
+static bool readFully(int fd, char* dst, size_t count, size_t offset) {
+  while (count > 0) {
+    ssize_t n = ::pread(fd, dst, count, offset);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    dst += n;
+    count -= n;
+    offset += n;
+  }
+  return true;
+}
+
+// print "<label> <file>: <MB> MB in <s> s (<MB/s> MB/s)"
+static void printRate(const char* label, const std::string& fileName, size_t numBytes, double seconds) {
+  double megaBytes = numBytes / (1024.0 * 1024.0);
+  double rate = seconds > 0 ? megaBytes / seconds : 0.0;
+
+  // keep the caller's stream format untouched
+  std::ios::fmtflags flags = std::cout.flags();
+  std::streamsize precision = std::cout.precision();
+  std::cout << "  " << label << " " << fileName << ": " << std::fixed << std::setprecision(2)
+            << megaBytes << " MB in " << seconds << " s (" << rate << " MB/s)" << std::endl;
+  std::cout.flags(flags);
+  std::cout.precision(precision);
+}
+
+// reserve numBytes of address space, pages are only backed once written
+static char* reserveBuffer(size_t numBytes) {
+  void* addr = mmap(nullptr, std::max(numBytes, (size_t)1), PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  return addr == MAP_FAILED ? nullptr : static_cast<char*>(addr);
+}
+
+// reserve numBytes of address space that is not usable, nor counted as
+// memory in use, until commitBuffer makes a front part of it writable
+static char* reserveAddressRange(size_t numBytes) {
+  void* addr = mmap(nullptr, std::max(numBytes, (size_t)1), PROT_NONE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  return addr == MAP_FAILED ? nullptr : static_cast<char*>(addr);
+}
+
+static void releaseBuffer(char* buffer, size_t numBytes) {
+  if (buffer != nullptr) {
+    munmap(buffer, std::max(numBytes, (size_t)1));
+  }
+}
+
+// uncompressed size modulo 4 GB from the trailer of the last gzip member
+static size_t gzipTrailerSize(int fd, size_t fileSize) {
+  unsigned char trailer[4];
+  if (fileSize < 4 || !readFully(fd, reinterpret_cast<char*>(trailer), 4, fileSize - 4)) {
+    return 0;
+  }
+  return trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) | ((size_t)trailer[3] << 24);
+}
+
+bool InputFile::open(const std::string& name, bool wait) {
+  close();
+
+  fileName = name;
+  fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd == -1) {
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+    close();
+    return false;
+  }
+  size_t fileSize = st.st_size;
+
+  unsigned char magic[2];
+  bool isGzip = fileSize >= 2 && readFully(fd, reinterpret_cast<char*>(magic), 2, 0) && magic[0] == 0x1f && magic[1] == 0x8b;
+  if (isGzip) {
+    // the inflated size is only known at the end: reserve the addresses for
+    // the largest expansion deflate allows, the loader commits memory behind
+    // them as the data grows
+    capacity = fileSize * GZIP_MAX_RATIO;
+    data = reserveAddressRange(capacity);
+    if (data == nullptr) {
+      // the address space is limited (ulimit -v), fall back to the size
+      // in the trailer, which is only right modulo 4 GB
+      capacity = gzipTrailerSize(fd, fileSize);
+      data = reserveAddressRange(capacity);
+    }
+    committed = 0;
+    int gzipFd = dup(fd);
+    gzipFile = gzipFd != -1 ? gzdopen(gzipFd, "rb") : nullptr;
+    if (gzipFile == nullptr) {
+      if (gzipFd != -1) {
+        ::close(gzipFd);
+      }
+      close();
+      return false;
+    }
+    gzbuffer(static_cast<gzFile>(gzipFile), IO_BLOCK_SIZE);
+    size = 0;
+  } else {
+    capacity = fileSize;
+    data = reserveBuffer(capacity);
+    committed = capacity;
+    size = fileSize;
+  }
+  if (data == nullptr) {
+    close();
+    return false;
+  }
+
+  // the loader fills the buffer front to back, readers follow behind it
+  loaded = 0;
+  finished = false;
+  failed = false;
+  stopped = false;
+  loader = isGzip ? std::thread(&InputFile::inflateFile, this) : std::thread(&InputFile::loadFile, this);
+  if (wait) {
+    waitAll();
+    if (hasError()) {
+      close();
+      return false;
+    }
+  }
+  return true;
+}
+
+void InputFile::finish(bool isFailed, size_t numBytes, double seconds) {
+  std::lock_guard<std::mutex> lock(mutex);
+  finished = true;
+  failed = isFailed;
+  stats.numBytes = numBytes;
+  stats.seconds = seconds;
+  cond.notify_all();
+}
+
+void InputFile::loadFile() {
+  auto startTime = std::chrono::steady_clock::now();
+  posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+  posix_fadvise(fd, 0, IO_BLOCK_SIZE, POSIX_FADV_WILLNEED);
+
+  size_t offset = 0;
+  bool isFailed = false;
+  while (offset < size) {
+    size_t blockSize = std::min((size_t)IO_BLOCK_SIZE, size - offset);
+    // ask for the following block while this one is read
+    if (offset + blockSize < size) {
+      posix_fadvise(fd, offset + blockSize, IO_BLOCK_SIZE, POSIX_FADV_WILLNEED);
+    }
+    if (!readFully(fd, data + offset, blockSize, offset)) {
+      isFailed = true;
+      break;
+    }
+    offset += blockSize;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    loaded = offset;
+    cond.notify_all();
+    if (stopped) {
+      break;
+    }
+  }
+  finish(isFailed, offset, secondsSince(startTime));
+}
+
+void InputFile::inflateFile() {
+  auto startTime = std::chrono::steady_clock::now();
+  gzFile file = static_cast<gzFile>(gzipFile);
+  size_t offset = 0;
+  bool isFailed = false;
+  while (true) {
+    size_t blockSize = std::min((size_t)IO_BLOCK_SIZE, capacity - offset);
+    int numBytes = 0;
+    if (blockSize == 0) {
+      // the reserved addresses are used up, fail if the file goes on
+      char extra;
+      isFailed = gzread(file, &extra, 1) != 0;
+    } else if (!commitBuffer(offset + blockSize)) {
+      isFailed = true;
+    } else {
+      numBytes = gzread(file, data + offset, blockSize);
+    }
+    if (numBytes <= 0) {
+      // a truncated file ends with Z_BUF_ERROR rather than a failed read
+      int errNum = Z_OK;
+      gzerror(file, &errNum);
+      isFailed = isFailed || numBytes < 0 || errNum != Z_OK;
+      break;
+    }
+    offset += numBytes;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    loaded = offset;
+    size = offset;
+    cond.notify_all();
+    if (stopped) {
+      break;
+    }
+  }
+  // compressed bytes are what was read from storage
+  size_t numBytes = gzoffset(file);
+  gzclose(file);
+  finish(isFailed, numBytes, secondsSince(startTime));
+}
+
+// make the first numBytes of data writable, doubling the committed part
+// so that a growing file is committed a logarithmic number of times
+bool InputFile::commitBuffer(size_t numBytes) {
+  if (numBytes <= committed) {
+    return true;
+  }
+  size_t newCommitted = std::min(capacity, std::max(numBytes, committed * 2));
+  if (mprotect(data, newCommitted, PROT_READ | PROT_WRITE) != 0) {
+    return false;
+  }
+  committed = newCommitted;
+  return true;
+}
+
+size_t InputFile::getSize() const {
+  waitAll();
+  std::lock_guard<std::mutex> lock(mutex);
+  return size;
+}
+
+const char* InputFile::waitBeyond(const char* pos) const {
+  size_t offset = pos - data;
+  std::unique_lock<std::mutex> lock(mutex);
+  cond.wait(lock, [&]() { return loaded > offset || finished; });
+  return data + loaded;
+}
+
+void InputFile::waitAll() const {
+  std::unique_lock<std::mutex> lock(mutex);
+  cond.wait(lock, [this]() { return finished; });
+}
+
+void InputFile::reportBandwidth() const {
+  waitAll();
+  std::lock_guard<std::mutex> lock(mutex);
+  printRate("I/O", fileName, stats.numBytes, stats.seconds);
+}
+
+void InputFile::close() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopped = true;
+  }
+  if (loader.joinable()) {
+    loader.join();
+  } else if (gzipFile != nullptr) {
+    // opened but the loader never started
+    gzclose(static_cast<gzFile>(gzipFile));
+  }
+  if (fd != -1) {
+    ::close(fd);
+  }
+  releaseBuffer(data, capacity);
+  fd = -1;
+  gzipFile = nullptr;
+  data = nullptr;
+  capacity = 0;
+  committed = 0;
+  size = 0;
+  loaded = 0;
+  finished = true;
+  failed = false;
+  stats = ReadStats();
+}
+
+InputStream::FileBuf::int_type InputStream::FileBuf::underflow() {
+  if (gptr() < egptr()) {
+    return traits_type::to_int_type(*gptr());
+  }
+  // the get area is the data loaded behind the last one
+  char* pos = egptr() != nullptr ? egptr() : const_cast<char*>(file.begin());
+  char* loadedEnd = const_cast<char*>(file.waitBeyond(pos));
+  if (loadedEnd == pos) {
+    return traits_type::eof();
+  }
+  setg(pos, pos, loadedEnd);
+  return traits_type::to_int_type(*gptr());
+}
+
+void InputStream::FileBuf::reset() {
+  file.close();
+  setg(nullptr, nullptr, nullptr);
+}
+
+bool InputStream::open(const std::string& name) {
+  close();
+
+  clear();
+  if (!fileBuf.file.open(name, false)) {
+    setstate(std::ios::failbit);
+    return false;
+  }
+  rdbuf(&fileBuf);
+  return true;
+}
+
+void InputStream::close() {
+  fileBuf.reset();
+  rdbuf(nullptr);
+}
+
+void reportThroughput(const std::string& fileName, size_t numBytes, double seconds) {
+  printRate("Parsed", fileName, numBytes, seconds);
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <istream>
+#include <ostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+
+// size of one sequential read, large enough to keep a network mount busy
+#define IO_BLOCK_SIZE (4 << 20)
+
+// bytes read from storage and the wall time it took
+struct ReadStats {
+    size_t numBytes;
+    double seconds;
+
+    ReadStats() : numBytes(0), seconds(0.0) {}
+};
+
+// read-only view of a whole input file
+// a background thread loads the file into memory with large sequential reads,
+// the kernel is asked to prefetch the following block while the current one is read;
+// gzip-compressed files are inflated by the same thread into the same buffer, so
+// readers follow decompression the way they follow reads
+class InputFile {
+    std::string fileName;
+    int fd;
+    void* gzipFile;    // zlib handle of a gzip file, owned by the loader
+    char* data;        // address range reserved with mmap, pages are backed once written
+    size_t capacity;   // bytes reserved at data, the size of a plain file
+    size_t committed;  // bytes at data a gzip file may be inflated into, grown by the loader
+
+    std::thread loader;
+    mutable std::mutex mutex;
+    mutable std::condition_variable cond;
+    size_t size;       // bytes in the file, for a gzip file only known once it is inflated
+    size_t loaded;     // bytes available at the front of data
+    bool finished;     // loader is done, successfully or not
+    bool failed;
+    bool stopped;
+    ReadStats stats;
+
+public:
+    InputFile() : fd(-1), gzipFile(nullptr), data(nullptr), capacity(0), committed(0), size(0), loaded(0),
+                  finished(true), failed(false), stopped(false) {}
+    ~InputFile() { close(); }
+
+    // without wait, open returns while the file is still loading;
+    // such a file must be read through a LineScanner or an InputStream
+    bool open(const std::string& name, bool wait = true);
+    void close();
+    bool is_open() const { return fd != -1; }
+    bool hasError() const { std::lock_guard<std::mutex> lock(mutex); return failed; }
+
+    const std::string& getName() const { return fileName; }
+    const char* begin() const { return data; }
+    // end and size wait for the loader
+    const char* end() const { return data + getSize(); }
+    size_t getSize() const;
+    // bound on the size while the file is loading
+    size_t getCapacity() const { return capacity; }
+
+    // block until some data after pos is loaded or the loader is done,
+    // return the end of the loaded data
+    const char* waitBeyond(const char* pos) const;
+    void waitAll() const;
+
+    // print the storage bandwidth achieved on the file, waits for the loader
+    void reportBandwidth() const;
+
+private:
+    InputFile(const InputFile&);
+    InputFile& operator=(const InputFile&);
+
+    void loadFile();
+    void inflateFile();
+    bool commitBuffer(size_t numBytes);
+    void finish(bool isFailed, size_t numBytes, double seconds);
+};
+
+// std::istream over a plain or gzip-compressed file loaded by an InputFile,
+// the stream reads the loaded data in place while the rest is still loading;
+// callers can use it in place of std::ifstream
+class InputStream : public std::istream {
+    class FileBuf : public std::streambuf {
+    public:
+        InputFile file;
+
+        void reset();
+    protected:
+        int_type underflow();
+    };
+
+    FileBuf fileBuf;
+
+public:
+    InputStream() : std::istream(nullptr) {}
+    explicit InputStream(const std::string& name) : std::istream(nullptr) { open(name); }
+
+    bool open(const std::string& name);
+    void close();
+    bool is_open() const { return fileBuf.file.is_open(); }
+    bool hasError() const { return fileBuf.file.hasError(); }
+
+    // print the storage bandwidth achieved on the file, waits for the loader
+    void reportBandwidth() const { fileBuf.file.reportBandwidth(); }
+};
+
+// iterate the lines of a memory buffer without copying
+// the line returned excludes the trailing '\n'
+class LineScanner {
+    const char* cursor;
+    const char* bufEnd;
+    const char* loadedEnd;
+    const InputFile* file;   // file still being loaded, nullptr for a plain buffer
+
+public:
+    LineScanner(const char* begin, const char* end) : cursor(begin), bufEnd(end), loadedEnd(end), file(nullptr) {}
+    // a gzip file may end short of its capacity, the scanner stops where the loader did
+    explicit LineScanner(const InputFile& inputFile) : LineScanner(inputFile, inputFile.begin()) {}
+    // scan from pos on, which must be loaded already
+    LineScanner(const InputFile& inputFile, const char* pos)
+        : cursor(pos), bufEnd(inputFile.begin() + inputFile.getCapacity()), loadedEnd(pos), file(&inputFile) {}
+
+    bool nextLine(const char*& lineBegin, const char*& lineEnd);
+};
+
+inline bool LineScanner::nextLine(const char*& lineBegin, const char*& lineEnd) {
+    if (cursor >= bufEnd) {
+        return false;
+    }
+    lineBegin = cursor;
+    const char* searchPos = cursor;
+    while (true) {
+        lineEnd = static_cast<const char*>(std::memchr(searchPos, '\n', loadedEnd - searchPos));
+        if (lineEnd != nullptr || loadedEnd >= bufEnd) {
+            break;
+        }
+        // the line continues past the loaded data
+        searchPos = loadedEnd;
+        loadedEnd = file->waitBeyond(loadedEnd);
+        if (loadedEnd == searchPos) {
+            // the file ended or the loader failed, stop at the data read so far
+            bufEnd = loadedEnd;
+            if (lineBegin == bufEnd) {
+                return false;
+            }
+        }
+    }
+    if (lineEnd == nullptr) {
+        lineEnd = bufEnd;
+        cursor = bufEnd;
+    } else {
+        cursor = lineEnd + 1;
+    }
+    return true;
+}
+
+// snapshot files hold arrays of plain records, written as they are in memory
+template <typename T>
+inline void writeArray(std::ostream& out, const std::vector<T>& arr) {
+    out.write(reinterpret_cast<const char*>(arr.data()), arr.size() * sizeof(T));
+}
+
+// copy count records at cursor into arr and move cursor past them,
+// false if the buffer ends before
+template <typename T>
+inline bool readArray(const char*& cursor, const char* end, size_t count, std::vector<T>& arr) {
+    size_t numBytes = count * sizeof(T);
+    if ((size_t)(end - cursor) < numBytes) {
+        return false;
+    }
+    arr.resize(count);
+    std::memcpy(arr.data(), cursor, numBytes);
+    cursor += numBytes;
+    return true;
+}
+
+// print parse throughput of an input file
+void reportThroughput(const std::string& fileName, size_t numBytes, double seconds);
@@ -1,8 +1,18 @@
 #include "global.h"
 
 std::map<std::string, Lib*> glbLibMap;
-std::map<int, Instance*> glbInstMap;
-std::map<int, Net*> glbNetMap;
+IdTable<Instance> glbInstMap;
+IdTable<Net> glbNetMap;
+PinStore glbPinStore;
+NetSinkStore glbNetSinks;
+PlacementStore glbBaselinePlacement;
+PlacementStore glbOptimizedPlacement;
+IdRenumbering glbInstIDs;
+IdRenumbering glbNetIDs;
+ObjectArena<Lib> glbLibArena;
+ObjectArena<Instance> glbInstArena;
+ObjectArena<Net> glbNetArena;
 Arch chip;
 RecSteinerMinTree rsmt;
 std::string lineBreaker = "------------------------------------------";
+int glbNumThreads = 1;
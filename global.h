@@ -6,11 +6,17 @@
 #include "lib.h"
 #include "arch.h"
 #include "rsmt.h"
+#include "idtable.h"
+#include "arena.h"
 
 // global variables
 extern std::map<std::string, Lib*> glbLibMap;
-extern std::map<int, Instance*> glbInstMap;
-extern std::map<int, Net*> glbNetMap;
+extern IdTable<Instance> glbInstMap;
+extern IdTable<Net> glbNetMap;
+extern ObjectArena<Lib> glbLibArena;        // owners of the objects in the maps above
+extern ObjectArena<Instance> glbInstArena;
+extern ObjectArena<Net> glbNetArena;
 extern Arch chip;
 extern RecSteinerMinTree rsmt;
-extern std::string lineBreaker;
\ No newline at end of file
+extern std::string lineBreaker;
+extern int glbNumThreads;   // worker threads used by the parallel readers
\ No newline at end of file
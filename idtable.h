@@ -0,0 +1,145 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <iterator>
+#include <cstddef>
+
+// largest ID an object may have; the ID-indexed tables are sized by the
+// largest ID, so readers reject a larger one rather than allocate for it
+#define MAX_OBJECT_ID ((1 << 26) - 1)
+
+// table of objects keyed by the numeric ID parsed from names like inst_12 or net_7
+// entries live in a vector indexed by ID with a validity bitmap next to it, so a
+// lookup is one index instead of a tree walk; the std::map-like interface iterates
+// valid entries in ascending ID order. IDs are expected to be dense and non-negative
+template <typename T>
+class IdTable {
+public:
+    typedef std::pair<int, T*> value_type;
+
+private:
+    std::vector<value_type> entries;   // entries[id].first == id
+    std::vector<bool> valid;           // entries[id] holds an object
+    size_t numValid;
+
+public:
+    template <typename Table, typename Value>
+    class IteratorBase {
+        Table* table;
+        size_t idx;
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename IdTable::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Value* pointer;
+        typedef Value& reference;
+
+        IteratorBase(Table* tablePtr, size_t pos) : table(tablePtr), idx(pos) { skipInvalid(); }
+
+        reference operator*() const { return table->entries[idx]; }
+        pointer operator->() const { return &table->entries[idx]; }
+        IteratorBase& operator++() { idx++; skipInvalid(); return *this; }
+        IteratorBase operator++(int) { IteratorBase it = *this; ++(*this); return it; }
+        bool operator==(const IteratorBase& other) const { return idx == other.idx; }
+        bool operator!=(const IteratorBase& other) const { return idx != other.idx; }
+
+    private:
+        void skipInvalid() {
+            while (idx < table->valid.size() && !table->valid[idx]) {
+                idx++;
+            }
+        }
+    };
+
+    typedef IteratorBase<IdTable, value_type> iterator;
+    typedef IteratorBase<const IdTable, const value_type> const_iterator;
+
+    IdTable() : numValid(0) {}
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, entries.size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, entries.size()); }
+
+    size_t size() const { return numValid; }
+    bool empty() const { return numValid == 0; }
+    bool contains(int id) const { return id >= 0 && (size_t)id < valid.size() && valid[id]; }
+
+    // object with the given ID, nullptr if there is none
+    T* get(int id) const { return contains(id) ? entries[id].second : nullptr; }
+
+    iterator find(int id) { return contains(id) ? iterator(this, id) : end(); }
+    const_iterator find(int id) const { return contains(id) ? const_iterator(this, id) : end(); }
+
+    // like std::map, a missing ID is inserted with a nullptr object;
+    // id is at most MAX_OBJECT_ID
+    T*& operator[](int id) {
+        if ((size_t)id >= entries.size()) {
+            size_t newSize = std::max((size_t)id + 1, entries.size() * 2);
+            entries.resize(newSize, value_type(-1, nullptr));
+            valid.resize(newSize, false);
+        }
+        if (!valid[id]) {
+            valid[id] = true;
+            entries[id] = value_type(id, nullptr);
+            numValid++;
+        }
+        return entries[id].second;
+    }
+
+    void reserve(size_t numIDs) {
+        entries.reserve(numIDs);
+        valid.reserve(numIDs);
+    }
+
+    void clear() {
+        entries.clear();
+        valid.clear();
+        numValid = 0;
+    }
+};
+
+// external IDs, the ones in the names and files, of objects whose internal IDs
+// were reassigned in placement order; the identity until that happens
+class IdRenumbering {
+    std::vector<int> externalIDs;   // by internal ID, empty for the identity
+    std::vector<int> internalIDs;   // by external ID, -1 if not in use
+
+public:
+    bool isIdentity() const { return externalIDs.empty(); }
+    int toExternal(int id) const { return externalIDs.empty() ? id : externalIDs[id]; }
+    // -1 if no object has the external ID
+    int toInternal(int extID) const {
+        if (externalIDs.empty()) {
+            return extID;
+        }
+        return extID >= 0 && (size_t)extID < internalIDs.size() ? internalIDs[extID] : -1;
+    }
+
+    // newIDs maps each current internal ID to its new one, -1 for unused IDs
+    void renumber(const std::vector<int>& newIDs, int numIDs) {
+        std::vector<int> newExternalIDs(numIDs, -1);
+        int maxExternalID = -1;
+        for (size_t id = 0; id < newIDs.size(); id++) {
+            if (newIDs[id] >= 0) {
+                newExternalIDs[newIDs[id]] = toExternal(id);
+                maxExternalID = std::max(maxExternalID, toExternal(id));
+            }
+        }
+        externalIDs.swap(newExternalIDs);
+        internalIDs.assign(maxExternalID + 1, -1);
+        for (int id = 0; id < numIDs; id++) {
+            if (externalIDs[id] >= 0) {
+                internalIDs[externalIDs[id]] = id;
+            }
+        }
+    }
+
+    void clear() {
+        externalIDs.clear();
+        internalIDs.clear();
+    }
+};
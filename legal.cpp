@@ -1,4 +1,5 @@
 #include <iomanip>
+#include <algorithm>
 #include "legal.h"
 #include "global.h"
 #include "object.h"
@@ -52,100 +53,88 @@ bool legalCheck() {
   }
 }
 
-bool checkTypeAndCapacity(bool isBaseline) {  
+template <typename View>
+bool checkTypeAndCapacity(const View& view) {  
   // check tile capacity
   int overflowTileCount = 0;
-  for (int i = 0; i < chip.getNumCol(); i++) {
-    for (int j = 0; j < chip.getNumRow(); j++) {
-
-      Tile* tile = chip.getTile(i, j);            
-      
-      std::list<std::pair<std::string, int> > overflow;
-      for (auto mapIter = tile->getInstanceMapBegin(); mapIter != tile->getInstanceMapEnd(); mapIter++) {
-        std::string modelType = mapIter->first;        
-        slotArr slots = mapIter->second;
-        for (int idx = 0; idx < (int)slots.size(); idx++) {
-          Slot* slot = slots[idx];
-          if (slot == nullptr) {
-            continue;
-          }
-          // check if the slot is legally occupied
-          std::list<int> instances;
-          if (isBaseline) {
-            instances = slot->getBaselineInstances();
-          } else {
-            instances = slot->getOptimizedInstances();
-          }
-          if (instances.size() > 1) {
-            // 1) 2-LUTs are allowed but total number of input should not exceed 6
-            if (modelType == "LUT") {
-              if (instances.size() > 2) {
-                overflow.push_back(std::pair<std::string, int>(modelType, idx));                        
-              } else {
-                std::set<int> totalInputs;
-                for (auto instID : instances) {
-                  Instance* instPtr = glbInstMap.find(instID)->second;
-                  std::vector<Pin*> inpins = instPtr->getInpins();
-                  for (auto pin : inpins) {
-                    if (pin->getNetID() != -1) {
-                      totalInputs.insert(pin->getNetID());
-                    }
-                  }                                    
-                }
-                if (totalInputs.size() > 6) {
-                  overflow.push_back(std::pair<std::string, int>(modelType, idx));
-                }
-              }
-            } else {
+  for (int tileIdx = 0; tileIdx < chip.getNumTiles(); tileIdx++) {
+
+    Tile* tile = chip.getTileByIndex(tileIdx);            
+    
+    std::list<std::pair<std::string, int> > overflow;
+    for (int kind = 0; kind < NUM_SLOT_KINDS; kind++) {
+      const Slot* slots = tile->getSlots((SlotKind)kind);
+      if (slots == nullptr) {
+        continue;
+      }
+      std::string modelType = slotKindNames[kind];
+      for (int idx = 0; idx < slotCapacity[kind]; idx++) {
+        const Slot* slot = &slots[idx];
+        // check if the slot is legally occupied
+        const SlotInstances& instances = view.instances(*slot);
+        if (instances.size() > 1) {
+          // 1) 2-LUTs are allowed but total number of input should not exceed 6
+          if (kind == SLOT_LUT) {
+            if (instances.size() > 2) {
               overflow.push_back(std::pair<std::string, int>(modelType, idx));                        
+            } else {
+              std::set<int> totalInputs;
+              for (auto instID : instances) {
+                Instance* instPtr = glbInstMap.get(instID);
+                for (int i = 0; i < instPtr->getNumInpins(); i++) {
+                  int netID = instPtr->getInpin(i).getNetID();
+                  if (netID != -1) {
+                    totalInputs.insert(netID);
+                  }
+                }                                    
+              }
+              if (totalInputs.size() > 6) {
+                overflow.push_back(std::pair<std::string, int>(modelType, idx));
+              }
             }
           } else {
-            // check DRAM and lut
-            if (modelType == "DRAM") {
-              if (isBaseline && slot->getBaselineInstances().empty()) {
-                continue;
-              } else if (!isBaseline && slot->getOptimizedInstances().empty()) {
-                continue;
-              }
-              // DRAM at slot0 blocks lut slot 0~3
-              // DRAM at slot1 blocks lut slot 4~7
-              slotArr* lutSlotArr = tile->getInstanceByType("LUT");
-              if (idx == 0) {
-                for (int lutIdx = 0; lutIdx < 4; lutIdx++) {
-                  Slot* lutSlot = (*lutSlotArr)[lutIdx];
-                  if (isBaseline && lutSlot->getBaselineInstances().size() > 0) {
-                    overflow.push_back(std::pair<std::string, int>("LUT-DRAM", lutIdx));
-                  } else if (!isBaseline && lutSlot->getOptimizedInstances().size() > 0) {
-                    overflow.push_back(std::pair<std::string, int>("LUT-DRAM", lutIdx));
-                  }
+            overflow.push_back(std::pair<std::string, int>(modelType, idx));                        
+          }
+        } else {
+          // check DRAM and lut
+          if (kind == SLOT_DRAM) {
+            if (view.instances(*slot).empty()) {
+              continue;
+            }
+            // DRAM at slot0 blocks lut slot 0~3
+            // DRAM at slot1 blocks lut slot 4~7
+            const Slot* lutSlots = tile->getSlots(SLOT_LUT);
+            if (idx == 0) {
+              for (int lutIdx = 0; lutIdx < 4; lutIdx++) {
+                const Slot* lutSlot = &lutSlots[lutIdx];
+                if (view.instances(*lutSlot).size() > 0) {
+                  overflow.push_back(std::pair<std::string, int>("LUT-DRAM", lutIdx));
                 }
-              } else if (idx == 1) {
-                for (int lutIdx = 4; lutIdx < 8; lutIdx++) {
-                  Slot* lutSlot = (*lutSlotArr)[lutIdx];
-                  if (isBaseline && lutSlot->getBaselineInstances().size() > 0) {
-                    overflow.push_back(std::pair<std::string, int>("LUT-DRAM", lutIdx));
-                  } else if (!isBaseline && lutSlot->getOptimizedInstances().size() > 0) {
-                    overflow.push_back(std::pair<std::string, int>("LUT-DRAM", lutIdx));
-                  }
+              }
+            } else if (idx == 1) {
+              for (int lutIdx = 4; lutIdx < 8; lutIdx++) {
+                const Slot* lutSlot = &lutSlots[lutIdx];
+                if (view.instances(*lutSlot).size() > 0) {
+                  overflow.push_back(std::pair<std::string, int>("LUT-DRAM", lutIdx));
                 }
-              } else {
-                // dram with invalid slot index
               }
+            } else {
+              // dram with invalid slot index
             }
           }
-        }  // end for each slot
-      }  // end for each slot type
-
-      // print error
-      if (overflow.empty() == false) {
-        std::cout << "Error: Tile " << tile->getLocStr() << " is over the capacity." << std::endl;
-        for (auto pair : overflow) {
-          std::cout << "  Slot type: " << pair.first << " slot index: " << pair.second << std::endl;
         }
-        overflowTileCount++;
-      }            
-    } // end for each row
-  } // end for each column
+      }  // end for each slot
+    }  // end for each slot type
+
+    // print error
+    if (overflow.empty() == false) {
+      std::cout << "Error: Tile " << tile->getLocStr() << " is over the capacity." << std::endl;
+      for (auto pair : overflow) {
+        std::cout << "  Slot type: " << pair.first << " slot index: " << pair.second << std::endl;
+      }
+      overflowTileCount++;
+    }            
+  } // end for each tile
 
   if (overflowTileCount > 0) {
     return false;
@@ -154,6 +143,10 @@ bool checkTypeAndCapacity(bool isBaseline) {
   }    
 }
 
+bool checkTypeAndCapacity(bool isBaseline) {
+  return isBaseline ? checkTypeAndCapacity(BaselineView()) : checkTypeAndCapacity(OptimizedView());
+}
+
 bool checkControlSet(bool isBaseline) {    
   // Return true if the control set is valid, otherwise return false
   int errorCount = 0;
@@ -162,67 +155,62 @@ bool checkControlSet(bool isBaseline) {
   std::map<int, int> tileClkCount;
   std::map<int, int> tileCeCount;
   std::map<int, int> tileResetCount;
-  for (int i = 0; i < chip.getNumCol(); i++) {
-    for (int j = 0; j < chip.getNumRow(); j++) {
-      Tile* tile = chip.getTile(i, j);
-      if (tile->matchType("PLB") == false) {
-        continue;        
+  for (int tileIdx : chip.getTilesOfType(TILE_PLB)) {
+    Tile* tile = chip.getTileByIndex(tileIdx);
+    tileCount++;
+
+    std::set<int> plbClkNets;
+    std::set<int> plbCeNets;
+    std::set<int> plbResetNets;
+    for (int bank = 0; bank < 2; bank++) {
+      std::set<int> clkNets;
+      std::set<int> ceNets;
+      std::set<int> srNets;
+      if (tile->getControlSet(isBaseline, bank, clkNets, ceNets, srNets) == false) {             
+        errorCount++;
       }
-      tileCount++;
-
-      std::set<int> plbClkNets;
-      std::set<int> plbCeNets;
-      std::set<int> plbResetNets;
-      for (int bank = 0; bank < 2; bank++) {
-        std::set<int> clkNets;
-        std::set<int> ceNets;
-        std::set<int> srNets;
-        if (tile->getControlSet(isBaseline, bank, clkNets, ceNets, srNets) == false) {             
-          errorCount++;
-        }
 
-        int numClk = clkNets.size();      
-        int numReset = srNets.size();    
-        int numCe = ceNets.size();
+      int numClk = clkNets.size();      
+      int numReset = srNets.size();    
+      int numCe = ceNets.size();
 
-        if (numClk > MAX_TILE_CLOCK_PER_PLB_BANK) {
-          std::cout << "Error: Multiple clock nets in bank " << bank << " of tile " << tile->getLocStr() << std::endl;
-          errorCount++;
-        }
-        if (numReset > MAX_TILE_RESET_PER_PLB_BANK) {
-          std::cout << "Error: Multiple reset nets in bank " << bank << " of tile " << tile->getLocStr() << std::endl;
-          errorCount++;
-        }  
-        if (numCe > MAX_TILE_CE_PER_PLB_BANK) {
-          std::cout << "Error: Multiple CE nets in bank " << bank << " of tile " << tile->getLocStr() << std::endl;        
-          errorCount++;
-        }  
-
-        // merge control sets in different banks
-        plbClkNets.insert(clkNets.begin(), clkNets.end());
-        plbCeNets.insert(ceNets.begin(), ceNets.end());
-        plbResetNets.insert(srNets.begin(), srNets.end());
+      if (numClk > MAX_TILE_CLOCK_PER_PLB_BANK) {
+        std::cout << "Error: Multiple clock nets in bank " << bank << " of tile " << tile->getLocStr() << std::endl;
+        errorCount++;
       }
+      if (numReset > MAX_TILE_RESET_PER_PLB_BANK) {
+        std::cout << "Error: Multiple reset nets in bank " << bank << " of tile " << tile->getLocStr() << std::endl;
+        errorCount++;
+      }  
+      if (numCe > MAX_TILE_CE_PER_PLB_BANK) {
+        std::cout << "Error: Multiple CE nets in bank " << bank << " of tile " << tile->getLocStr() << std::endl;        
+        errorCount++;
+      }  
 
-      int plbCeCount = (int)plbCeNets.size();
-      int plbClkCount = (int)plbClkNets.size();
-      int plbResetCount = (int)plbResetNets.size();
-
-      if (tileCeCount.find(plbCeCount) == tileCeCount.end()) {
-        tileCeCount[plbCeCount] = 1;
-      } else {
-        tileCeCount[plbCeCount]++;
-      } 
-      if (tileClkCount.find(plbClkCount) == tileClkCount.end()) {
-        tileClkCount[plbClkCount] = 1;
-      } else {
-        tileClkCount[plbClkCount]++;
-      }
-      if (tileResetCount.find(plbResetCount) == tileResetCount.end()) {
-        tileResetCount[plbResetCount] = 1;
-      } else {
-        tileResetCount[plbResetCount]++;
-      }
+      // merge control sets in different banks
+      plbClkNets.insert(clkNets.begin(), clkNets.end());
+      plbCeNets.insert(ceNets.begin(), ceNets.end());
+      plbResetNets.insert(srNets.begin(), srNets.end());
+    }
+
+    int plbCeCount = (int)plbCeNets.size();
+    int plbClkCount = (int)plbClkNets.size();
+    int plbResetCount = (int)plbResetNets.size();
+
+    if (tileCeCount.find(plbCeCount) == tileCeCount.end()) {
+      tileCeCount[plbCeCount] = 1;
+    } else {
+      tileCeCount[plbCeCount]++;
+    } 
+    if (tileClkCount.find(plbClkCount) == tileClkCount.end()) {
+      tileClkCount[plbClkCount] = 1;
+    } else {
+      tileClkCount[plbClkCount]++;
+    }
+    if (tileResetCount.find(plbResetCount) == tileResetCount.end()) {
+      tileResetCount[plbResetCount] = 1;
+    } else {
+      tileResetCount[plbResetCount]++;
     }
   }
 
@@ -254,7 +242,8 @@ bool checkControlSet(bool isBaseline) {
   }   
 }
 
-bool checkClockRegion(bool isBaseline) {    
+template <typename View>
+bool checkClockRegion(const View& view) {    
   // Return true if the clock region is valid, otherwise return false
   int errorCount = 0;
   
@@ -266,50 +255,51 @@ bool checkClockRegion(bool isBaseline) {
     }
   }
 
+  const PlacementStore& placement = view.placement();
+  std::vector<int> outsideInstIDs;   // external IDs, reported in file order
   for (auto inst : glbInstMap) {
-    int instCol;
-    int instRow;
-    if (isBaseline) {
-      instCol  = std::get<0>(inst.second->getBaseLocation());
-      instRow  = std::get<1>(inst.second->getBaseLocation());
-    } else {
-      instCol  = std::get<0>(inst.second->getLocation());
-      instRow  = std::get<1>(inst.second->getLocation());
-    }    
+    int instCol = placement.getX(inst.first);
+    int instRow = placement.getY(inst.first);
     int clockCol = -1;
     int clockRow = -1;
     if (chip.getClockRegionCoordinate(instCol, instRow, clockCol, clockRow) == false) {
-      std::cout << "Error: Instance " << inst.second->getInstanceName() << " is not in any clock region." << std::endl;
+      outsideInstIDs.push_back(glbInstIDs.toExternal(inst.first));
       errorCount++;
       continue;
     }
 
     ClockRegion* clockRegion = chip.getClockRegion(clockCol, clockRow);
-    // check each pin of the instance
-    for (int idx = 0; idx < inst.second->getNumInpins(); idx++) {
-      Pin* pin = inst.second->getInpin(idx);
-      int netID = pin->getNetID();
-      if (pin->getProp() == PIN_PROP_CLOCK && netID != -1) { // connected clock pin
-        Net* netPtr = glbNetMap.find(netID)->second;
+    const Lib* lib = inst.second->getCellLib();
+    if (lib == nullptr) {
+      continue;
+    }
+    // check each clock pin of the instance
+    for (int idx : lib->getInputsWithProp(PIN_PROP_CLOCK)) {
+      int netID = inst.second->getInpin(idx).getNetID();
+      if (netID != -1) { // connected clock pin
+        Net* netPtr = glbNetMap.get(netID);
         if (netPtr->isClock()) {
-          clockRegion->addClockNet(pin->getNetID());   
+          clockRegion->addClockNet(netID);   
         }
       }
     }
 
-    // check each pin of the instance
-    for (int idx = 0; idx < inst.second->getNumOutpins(); idx++) {
-      Pin* pin = inst.second->getOutpin(idx);
-      int netID = pin->getNetID();
-      if (pin->getProp() == PIN_PROP_CLOCK && netID != -1) { // connected clock pin
-        Net* netPtr = glbNetMap.find(netID)->second;
+    for (int idx : lib->getOutputsWithProp(PIN_PROP_CLOCK)) {
+      int netID = inst.second->getOutpin(idx).getNetID();
+      if (netID != -1) { // connected clock pin
+        Net* netPtr = glbNetMap.get(netID);
         if (netPtr->isClock()) {
-          clockRegion->addClockNet(pin->getNetID());   
+          clockRegion->addClockNet(netID);   
         }
       }
     }
   }
 
+  std::sort(outsideInstIDs.begin(), outsideInstIDs.end());
+  for (int instID : outsideInstIDs) {
+    std::cout << "Error: Instance inst_" << instID << " is not in any clock region." << std::endl;
+  }
+
   // report clock region
   int overflowRegionCount = 0;
   for (int j = chip.getNumClockRow() - 1; j >=0 ; j--) {
@@ -338,6 +328,10 @@ bool checkClockRegion(bool isBaseline) {
   }   
 }
 
+bool checkClockRegion(bool isBaseline) {
+  return isBaseline ? checkClockRegion(BaselineView()) : checkClockRegion(OptimizedView());
+}
+
 void reportClockRegion(const int col, const int row) {
 
   std::cout << "  Baseline:" << std::endl;
@@ -357,3 +351,9 @@ void reportClockRegion(const int col, const int row) {
     clockRegion->reportClockRegion();  // report optimized placement
   }  
 }
+
+// placement views the checks are compiled for
+template bool checkTypeAndCapacity(const BaselineView&);
+template bool checkTypeAndCapacity(const OptimizedView&);
+template bool checkClockRegion(const BaselineView&);
+template bool checkClockRegion(const OptimizedView&);
@@ -7,8 +7,13 @@
 
 bool legalCheck();  // check tile type and capacity 
 
+// the checks are templated on a placement view, see BaselineView
+template <typename View>
+bool checkTypeAndCapacity(const View& view);
 bool checkTypeAndCapacity(bool isBaseline);
 bool checkControlSet(bool isBaseline);
+template <typename View>
+bool checkClockRegion(const View& view);
 bool checkClockRegion(bool isBaseline);
 
 void reportClockRegion(const int col, const int row);
\ No newline at end of file
@@ -1,8 +1,54 @@
 #include <iostream>
-#include <fstream>
-#include <sstream>
+#include <vector>
 #include "lib.h"
 #include "global.h"
+#include "fileio.h"
+#include "util.h"
+
+// a pin line of the cell being read
+struct LibPinRecord {
+    int idx;
+    std::string name;
+    PinProp prop;
+};
+
+// create the lib of a cell from its pin lines, false on error
+static bool createLib(const std::string& cellNameStr, int numInPin, int numOutPin,
+                      const std::vector<LibPinRecord>& inPins, const std::vector<LibPinRecord>& outPins) {
+    // check if lib already exists in map
+    if (glbLibMap.find(cellNameStr) != glbLibMap.end()) {
+        std::cout << "Library already exists: " << cellNameStr << std::endl;
+        return false;
+    }
+
+    // create new lib
+    Lib* newLib = glbLibArena.create(cellNameStr);
+    newLib->setNumInputs(numInPin);
+    newLib->setNumOutputs(numOutPin);
+
+    bool isValid = true;
+    for (const auto& pin : inPins) {
+        if (pin.idx < 0 || pin.idx >= numInPin) {
+            std::cout << "Invalid pin name: " << pin.name << std::endl;
+            isValid = false;
+            continue;
+        }
+        newLib->setInput(pin.idx, pin.name, pin.prop);
+    }
+    for (const auto& pin : outPins) {
+        if (pin.idx < 0 || pin.idx >= numOutPin) {
+            std::cout << "Invalid pin name: " << pin.name << std::endl;
+            isValid = false;
+            continue;
+        }
+        newLib->setOutput(pin.idx, pin.name, pin.prop);
+    }
+    newLib->buildPinTables();
+
+    // add lib to map
+    glbLibMap[cellNameStr] = newLib;
+    return isValid;
+}
 
 bool readAndCreateLib(std::string libFilename) {
     if (glbLibMap.empty() == false) {
@@ -11,123 +57,100 @@ bool readAndCreateLib(std::string libFilename) {
     }
 
     // read lib file
-    std::ifstream libFile(libFilename);
+    InputStream libFile(libFilename);
     if (!libFile.is_open()) {
         std::cout << "Failed to open file: " << libFilename << std::endl;
         return false;
     }
 
+    // each cell is built in one pass over its lines
     std::string line;
-    std::vector<std::string> pinLines;
     unsigned int numErr = 0;
     bool isInsideCell = false;
     std::string cellNameStr;
+    int numInPin = 0;
+    int numOutPin = 0;
+    std::vector<LibPinRecord> inPins;
+    std::vector<LibPinRecord> outPins;
+    Token tokens[4];
     while (std::getline(libFile, line)) {
         if (line.empty() || line[0] == '#') {
             continue;
         }
+        const char* lineBegin = line.data();
+        const char* lineEnd = lineBegin + line.size();
 
-        if (line.substr(0, 4) == "CELL") {
+        if (line.compare(0, 4, "CELL") == 0) {
             isInsideCell = true;
-            cellNameStr = line.substr(4);
+            cellNameStr.clear();
+            if (tokenizeLine(lineBegin + 4, lineEnd, tokens, 1) > 0) {
+                cellNameStr = tokens[0].str();
+            }
+            numInPin = 0;
+            numOutPin = 0;
+            inPins.clear();
+            outPins.clear();
+            continue;
         }
-        if (isInsideCell) {
-            pinLines.push_back(line);
+        if (!isInsideCell) {
+            continue;
         }
 
-        if (line.substr(0, 8) == "END_CELL") {
+        if (line.compare(0, 8, "END_CELL") == 0) {
             isInsideCell = false;
-            
-            // process lib 
-            std::istringstream iss(cellNameStr);
-            std::vector<std::string> tokens;
-            std::string token;
-            while (iss >> token) {
-                tokens.push_back(token);
+            if (createLib(cellNameStr, numInPin, numOutPin, inPins, outPins) == false) {
+                numErr++;
             }
+            continue;
+        }
 
-            cellNameStr = tokens[0];
+        // PIN <name> <INPUT|OUTPUT> [CTRL|CLOCK|RESET]
+        int numTokens = tokenizeLine(lineBegin, lineEnd, tokens, 4);
+        if (numTokens != 3 && numTokens != 4) {
+            continue;
+        }
+        std::vector<LibPinRecord>* pins = nullptr;
+        if (tokens[2].equals("INPUT")) {
+            numInPin++;
+            pins = &inPins;
+        } else if (tokens[2].equals("OUTPUT")) {
+            numOutPin++;
+            pins = &outPins;
+        } else {
+            std::cout << "Invalid pin type: " << tokens[2].str() << std::endl;
+            numErr++;
+            continue;
+        }
 
-            // check if lib already exists in map
-            if (glbLibMap.find(cellNameStr) != glbLibMap.end()) {
-                std::cout << "Library already exists: " << cellNameStr << std::endl;
+        PinProp prop = PIN_PROP_NONE;
+        if (numTokens == 4) {
+            if (tokens[3].equals("CTRL")) {
+                prop = PIN_PROP_CE;
+            } else if (tokens[3].equals("CLOCK")) {
+                prop = PIN_PROP_CLOCK;
+            } else if (tokens[3].equals("RESET")) {
+                prop = PIN_PROP_RESET;
+            } else {
+                std::cout << "Invalid pin property: " << tokens[3].str() << std::endl;
                 numErr++;
                 continue;
-            } else {
-                // create new lib
-                Lib* newLib = new Lib(cellNameStr);
-
-                // create pin of this lib
-                int numInPin = 0;
-                int numOutPin = 0;
-                for (auto pin : pinLines) {
-                    std::istringstream pinss(pin);
-                    std::vector<std::string> pinTokens;
-                    std::string pinToken;
-                    while (pinss >> pinToken) {
-                        pinTokens.push_back(pinToken);
-                    }
-                    if ( pinTokens.size() != 3 && pinTokens.size() != 4) {
-                        continue;
-                    }
-                    if (pinTokens[2] == "INPUT") {
-                        numInPin++;
-                    } else if (pinTokens[2] == "OUTPUT") {
-                        numOutPin++;
-                    } else {
-                        std::cout << "Invalid pin type: " << pinTokens[2] << std::endl;
-                        numErr++;
-                        continue;
-                    }
-                }
-                newLib->setNumInputs(numInPin);
-                newLib->setNumOutputs(numOutPin);  
-
-                for (auto pin : pinLines) {
-                    std::istringstream pinss(pin);
-                    std::vector<std::string> pinTokens;
-                    std::string pinToken;
-                    while (pinss >> pinToken) {
-                        pinTokens.push_back(pinToken);
-                    }
-                    if ( pinTokens.size() != 3 && pinTokens.size() != 4) {
-                        continue;
-                    }
-
-                    PinProp prop = PIN_PROP_NONE;
-                    if (pinTokens.size() == 4) {
-                        if (pinTokens[3] == "CTRL") {
-                            prop = PIN_PROP_CE;
-                        } else if (pinTokens[3] == "CLOCK") {
-                            prop = PIN_PROP_CLOCK;
-                        } else if (pinTokens[3] == "RESET") {
-                            prop = PIN_PROP_RESET;
-                        } else {
-                            std::cout << "Invalid pin property: " << pinTokens[3] << std::endl;
-                            numErr++;
-                            continue;
-                        } 
-                    }                    
-
-                    size_t underscorePos = pinTokens[1].find('_');
-                    std::string subStr = pinTokens[1].substr(underscorePos + 1);
-                    int pinIdx = std::stoi(subStr);
-                    if (pinTokens[2] == "INPUT") {
-                        newLib->setInput(pinIdx, pinTokens[1], prop);
-                    } else if (pinTokens[2] == "OUTPUT") {
-                        newLib->setOutput(pinIdx, pinTokens[1], prop);
-                    } else {
-                        std::cout << "Invalid pin type: " << pinTokens[2] << std::endl;
-                        numErr++;
-                        continue;
-                    }
-                }
-                // add lib to map
-                glbLibMap[cellNameStr] = newLib;
-                pinLines.clear();
             }
         }
+
+        LibPinRecord pin;
+        pin.name = tokens[1].str();
+        pin.prop = prop;
+        if (!parseNameID(tokens[1], pin.idx)) {
+            pin.idx = -1;
+        }
+        pins->push_back(pin);
+    }
+
+    if (libFile.hasError()) {
+        std::cout << "Failed to read file: " << libFilename << std::endl;
+        numErr++;
     }
+    libFile.reportBandwidth();
 
     if (numErr > 0) {
         return false;
@@ -135,4 +158,4 @@ bool readAndCreateLib(std::string libFilename) {
         return true;
     }
 
-}
\ No newline at end of file
+}
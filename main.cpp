@@ -1,10 +1,16 @@
+#include <thread>
+#include <algorithm>
 #include "object.h"
 #include "lib.h"
 #include "arch.h"
+#include "archdb.h"
 #include "netlist.h"
+#include "designdb.h"
+#include "outputbin.h"
 #include "legal.h"
 #include "wirelength.h"
 #include "pindensity.h"
+#include "renumber.h"
 #include "global.h"
 #include "rsmt.h"
 
@@ -59,18 +65,32 @@ int main(int argc, char* argv[]) {
                   std::cout << "  Successfully read architecture files." << std::endl;
               }
           }
+      } else if (tokens[0] == "write_arch_db") {
+          if (tokens.size() != 2) {
+              std::cout << "Invalid format of " << command << std::endl;
+              std::cout << "Usage: write_arch_db <db_file>" << std::endl;
+              result = false;
+          } else if (!writeArchDB(tokens[1])) {
+              result = false;
+          }
+      } else if (tokens[0] == "read_arch_db") {
+          if (tokens.size() != 2) {
+              std::cout << "Invalid format of " << command << std::endl;
+              std::cout << "Usage: read_arch_db <db_file>" << std::endl;
+              result = false;
+          } else {
+              if (!readArchDB(tokens[1])) {
+                  result = false;
+              } else {
+                  std::cout << "  Successfully read architecture database." << std::endl;
+              }
+          }
       } else if (tokens[0] == "read_design") {
           if (tokens.size() == 4) {
               std::string inputNodeFileName = tokens[1];
               std::string inputNetFileName = tokens[2];
               std::string inputTimingFileName = tokens[3];
-              if (!readInputNodes(inputNodeFileName)) {
-                  result = false;
-              }
-              if (!readInputNets(inputNetFileName)) {
-                  result = false;
-              }
-              if (!readInputTiming(inputTimingFileName)) {
+              if (!readDesign(inputNodeFileName, inputNetFileName, inputTimingFileName)) {
                   result = false;
               }
               if (result == true) {                 
@@ -81,10 +101,31 @@ int main(int argc, char* argv[]) {
               std::cout << "Usage: read_design <input_node_file> <input_net_file> <timing_file>" << std::endl;
               result = false;
           }
-      } else if (tokens[0] == "read_output") {
+      } else if (tokens[0] == "write_design_db") {
+          if (tokens.size() != 2) {
+              std::cout << "Invalid format of " << command << std::endl;
+              std::cout << "Usage: write_design_db <db_file>" << std::endl;
+              result = false;
+          } else if (!writeDesignDB(tokens[1])) {
+              result = false;
+          }
+      } else if (tokens[0] == "read_design_db") {
           if (tokens.size() != 2) {
               std::cout << "Invalid format of " << command << std::endl;
-              std::cout << "Usage: read_output <output_node_file>" << std::endl;
+              std::cout << "Usage: read_design_db <db_file>" << std::endl;
+              result = false;
+          } else {
+              if (!readDesignDB(tokens[1])) {
+                  result = false;
+              }
+              if (result == true) {
+                  std::cout << "  Successfully read design database." << std::endl;
+              }
+          }
+      } else if (tokens[0] == "read_output") {
+          if (tokens.size() != 2 && !(tokens.size() == 3 && tokens[2] == "-renumber")) {
+              std::cout << "Invalid format of " << command << std::endl;
+              std::cout << "Usage: read_output <output_node_file> [-renumber]" << std::endl;
               result = false;
           } else {
               std::string outputNodeFileName = tokens[1];
@@ -93,8 +134,59 @@ int main(int argc, char* argv[]) {
               }
               if (result == true) {                 
                   std::cout << "  Successfully read output file." << std::endl;                
+                  if (tokens.size() == 3) {
+                      renumberDesign();
+                  }
               }
           }
+      } else if (tokens[0] == "read_output_delta") {
+          if (tokens.size() != 2 && !(tokens.size() == 3 && tokens[2] == "-validate")) {
+              std::cout << "Invalid format of " << command << std::endl;
+              std::cout << "Usage: read_output_delta <delta_node_file> [-validate]" << std::endl;
+              result = false;
+          } else {
+              if (!readOutputDelta(tokens[1], tokens.size() == 3)) {
+                  result = false;
+              }
+              if (result == true) {
+                  std::cout << "  Successfully read output delta file." << std::endl;
+              }
+          }
+      } else if (tokens[0] == "read_output_bin") {
+          if (tokens.size() != 2) {
+              std::cout << "Invalid format of " << command << std::endl;
+              std::cout << "Usage: read_output_bin <output_bin_file>" << std::endl;
+              result = false;
+          } else {
+              if (!readOutputBin(tokens[1])) {
+                  result = false;
+              }
+              if (result == true) {
+                  std::cout << "  Successfully read output file." << std::endl;
+              }
+          }
+      } else if (tokens[0] == "convert_output") {
+          if (tokens.size() != 3) {
+              std::cout << "Invalid format of " << command << std::endl;
+              std::cout << "Usage: convert_output <input_file> <output_file>" << std::endl;
+              result = false;
+          } else if (!convertOutput(tokens[1], tokens[2])) {
+              result = false;
+          }
+      } else if (tokens[0] == "set_threads") {
+          if (tokens.size() != 2) {
+              std::cout << "Invalid format of " << command << std::endl;
+              std::cout << "Usage: set_threads <num_threads>" << std::endl;
+              result = false;
+          } else {
+              // 0 means all available cores
+              int numThreads = std::stoi(tokens[1]);
+              if (numThreads <= 0) {
+                  numThreads = std::thread::hardware_concurrency();
+              }
+              glbNumThreads = std::max(numThreads, 1);
+              std::cout << "  Using " << glbNumThreads << " threads." << std::endl;
+          }
       } else if (tokens[0] == "report_arch") {
           chip.reportArch();
       } else if (tokens[0] == "report_design") {
@@ -127,12 +219,13 @@ int main(int argc, char* argv[]) {
           } else {
               int col = std::stoi(tokens[1]);
               int row = std::stoi(tokens[2]);
-              if (col > chip.getNumCol() || row > chip.getNumRow()) {
+              Tile* tile = chip.getTile(col, row);
+              if (tile == nullptr) {
                   std::cout << "Invalid tile coordinate: " << col << " " << row << std::endl;
                   result = false;
+              } else {
+                  tile->reportTile();
               }
-              Tile* tile = chip.getTile(col, row);
-              tile->reportTile();
           } 
           
       } else if (tokens[0] == "report_net") {
@@ -146,14 +239,17 @@ int main(int argc, char* argv[]) {
                   std::string subStr = netName.substr(underscorePos + 1);
                   // Convert the second substring to an integer
                   int netID = std::stoi(subStr);
-                  if (glbNetMap.find(netID) == glbNetMap.end()) {
+                  Net* net = glbNetMap.get(glbNetIDs.toInternal(netID));
+                  if (net == nullptr) {
                       std::cout << "Error: Net ID " << netID << " not found" << std::endl;
                   } else {
-                      Net* net = glbNetMap[netID];
                       net->reportNet();
                   }
               }
           } 
+      } else if (tokens[0] == "reset_design") {
+          resetDesign();
+          std::cout << "  Design cleared." << std::endl;
       } else if (tokens[0] == "exit") {
           break;
       } else {
@@ -165,16 +261,7 @@ int main(int argc, char* argv[]) {
       }
        std::cout <<std::endl;
   }
-  // free memory before exit
-  for (auto& lib : glbLibMap) {
-      delete lib.second;
-  }
-  for (auto& inst : glbInstMap) {
-      delete inst.second;
-  }
-  for (auto& net : glbNetMap) {
-      delete net.second;
-  }
+  // design and arch objects are released in bulk with their arenas
   std::cout << "Main program result: " << std::boolalpha << result << std::endl;
   return result ? 0 : 1;
 }
@@ -1,79 +1,339 @@
 #include <iomanip>
+#include <chrono>
+#include <algorithm>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
 #include "netlist.h"
 #include "global.h"
 #include "util.h"
+#include "fileio.h"
 
-bool readInputTiming(const std::string& fileName) {
-  std::ifstream inputFile(fileName);
-  if (!inputFile.is_open()) {
-    std::cout << "Failed to open file: " << fileName << std::endl;
-    return false;
+// model name lookup for the zero-copy readers, avoids building a string per line
+typedef std::vector<std::pair<std::string, Lib*> > LibTable;
+
+static LibTable buildLibTable() {
+  LibTable libTable;
+  for (const auto& pair : glbLibMap) {
+    libTable.push_back(pair);
+  }
+  return libTable;
+}
+
+static Lib* findLib(const LibTable& libTable, const Token& type) {
+  for (const auto& entry : libTable) {
+    if (type.equals(entry.first)) {
+      return entry.second;
+    }
+  }
+  return nullptr;
+}
+
+static double secondsSince(const std::chrono::steady_clock::time_point& startTime) {
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+  return elapsed.count();
+}
+
+// token idx of a line kept in a record, the link phases only tokenize
+// the line again to report an error
+static Token lineToken(const Token& line, int idx) {
+  Token tokens[3] = {};
+  tokenizeLine(line.begin, line.end, tokens, idx + 1);
+  return tokens[idx];
+}
+
+// parse phase record of one .nodes line "<location> <type> <name> [FIXED]"
+enum NodeStatus {
+  NODE_OK,
+  NODE_BAD_FORMAT,      // less than three tokens
+  NODE_BAD_LOCATION,
+  NODE_BAD_NAME
+};
+
+struct NodeRecord {
+  NodeStatus status;
+  int instID;
+  int x;
+  int y;
+  int z;
+  bool isFixed;
+  Lib* lib;             // nullptr if the model is not in the library
+  Token line;           // kept for error messages
+};
+
+// .nodes file and its parse phase records
+struct NodeFile {
+  InputFile file;
+  std::vector<NodeRecord> nodes;
+  double seconds;       // time spent in both phases
+
+  NodeFile() : seconds(0.0) {}
+};
+
+// parse phase: glbLibMap is only read here, the design is not touched
+static void parseNodeFile(NodeFile& nodeFile) {
+  auto startTime = std::chrono::steady_clock::now();
+  LibTable libTable = buildLibTable();
+
+  LineScanner scanner(nodeFile.file);
+  const char* lineBegin;
+  const char* lineEnd;
+  while (scanner.nextLine(lineBegin, lineEnd)) {
+    if (lineBegin == lineEnd || lineBegin[0] == '#') {
+      continue;
+    }
+
+    Token tokens[4];
+    int numTokens = tokenizeLine(lineBegin, lineEnd, tokens, 4);
+    if (numTokens == 0) {
+      continue;
+    }
+    nodeFile.nodes.emplace_back();
+    NodeRecord& node = nodeFile.nodes.back();
+    node.instID = -1;
+    node.isFixed = false;
+    node.lib = nullptr;
+    node.line.begin = lineBegin;
+    node.line.end = lineEnd;
+    if (numTokens < 3) {
+      node.status = NODE_BAD_FORMAT;
+      continue;
+    }
+    if (numTokens == 4) {
+      node.isFixed = tokens[3].equals("FIXED");
+    }
+    if (!parseLocation(tokens[0], node.x, node.y, node.z)) {
+      node.status = NODE_BAD_LOCATION;
+    } else if (!parseNameID(tokens[2], node.instID)) {
+      node.status = NODE_BAD_NAME;
+    } else {
+      node.status = NODE_OK;
+      node.lib = findLib(libTable, tokens[1]);
+    }
+  }
+  nodeFile.seconds += secondsSince(startTime);
+}
+
+// link phase: create the instances and add their baseline coordinate to the tiles
+static bool linkNodeFile(NodeFile& nodeFile) {
+  auto startTime = std::chrono::steady_clock::now();
+
+  // clear all baseline instances in all tiles 
+  for (int tileIdx = 0; tileIdx < chip.getNumTiles(); tileIdx++) {
+    Tile* tile = chip.getTileByIndex(tileIdx);
+    // new input netlist is being read, clear all existing instances in the tile
+    tile->clearInstances();   
   }
 
-  std::string line;    
   int errCnt = 0;
-  while (std::getline(inputFile, line)) {        
-    if (line.empty() || line[0] == '#') {
+  for (const NodeRecord& node : nodeFile.nodes) {
+    if (node.status == NODE_BAD_FORMAT) {
+      std::cout << "Error: Invalid format of " << node.line.str() << std::endl;
+      errCnt++;
+      continue;
+    }
+    if (node.status == NODE_BAD_LOCATION) {
+      std::cout << "Error: Invalid location format: " << lineToken(node.line, 0).str() << std::endl;
+      errCnt++;
+      continue;
+    }
+    Tile* tilePtr = chip.getTile(node.x, node.y);
+    if (tilePtr == nullptr) {
+      std::cout << "Error: Location " << lineToken(node.line, 0).str() << " is outside the chip." << std::endl;
+      errCnt++;
+      continue;
+    }
+    if (node.status == NODE_BAD_NAME) {
+      std::cout << "Error: Invalid name format: " << lineToken(node.line, 2).str() << std::endl;
+      errCnt++;
       continue;
     }
+    if (node.instID > MAX_OBJECT_ID) {
+      std::cout << "Error: ID of instance " << lineToken(node.line, 2).str() << " is larger than " << MAX_OBJECT_ID << std::endl;
+      errCnt++;
+      continue;
+    }
+     
+    // Check if the instance already exists in the map
+    if (glbInstMap.find(node.instID) != glbInstMap.end()) {
+      std::cout << "Error: Instance with name " << lineToken(node.line, 2).str() << " already exists in the map." << std::endl;
+      errCnt++;
+      continue; // Skip adding the instance to the map
+    }
+    
+    // Find the corresponding Lib object
+    Lib* libPtr = node.lib;
+    if (libPtr == nullptr) {
+      std::cout << "Error: Library with name " << lineToken(node.line, 1).str() << " not found." << std::endl;
+      errCnt++;
+      continue; 
+    }
 
-    std::istringstream iss(line);
-    std::string instName, pinName;
+    // Add the new instance object to the instMap
+    Instance* newInstance = glbInstArena.create(node.instID);
+    newInstance->setBaseLocation(std::make_tuple(node.x, node.y, node.z));
+    newInstance->setFixed(node.isFixed);
+    newInstance->setCellLib(libPtr);
+    glbInstMap[node.instID] = newInstance;
 
-    std::vector<std::string> tokens;
-    std::string token;
-    while (iss >> token) {
-      tokens.push_back(token);
+    // add baseline coordinate to the corresponding tile
+    if (tilePtr->addInstance(node.instID, node.z, libPtr, true) == false) {
+      std::cout << "Error: Failed to add baseline coordinate for instance " << lineToken(node.line, 2).str() << std::endl;
+      return false;
+    } 
+  }
+  if (nodeFile.file.hasError()) {
+    std::cout << "Failed to read file: " << nodeFile.file.getName() << std::endl;
+    errCnt++;
+  }
+  nodeFile.seconds += secondsSince(startTime);
+
+  if (errCnt > 0) {
+    return false;
+  } else {
+    return true;
+  }
+}
+
+bool readInputNodes(const std::string& fileName) {
+  // Implementation of readInputNetlist function
+  NodeFile nodeFile;
+  if (!nodeFile.file.open(fileName, false)) {
+    std::cout << "Failed to open file: " << fileName << std::endl;
+    return false;
+  }
+  parseNodeFile(nodeFile);
+  bool isValid = linkNodeFile(nodeFile);
+  reportThroughput(fileName, nodeFile.file.getSize(), nodeFile.seconds);
+  nodeFile.file.reportBandwidth();
+  return isValid;
+}
+
+// parse phase record of one .timing line "<inst> <pin>"
+enum TimingStatus {
+  TIMING_OK,
+  TIMING_BAD_FORMAT,      // not exactly two tokens, reported but not an error
+  TIMING_BAD_INST_NAME,   // instance name without ID
+  TIMING_NO_PIN_ID,       // pin name without '_', ignored
+  TIMING_BAD_PIN_NAME     // pin direction is not I/O
+};
+
+struct TimingRecord {
+  int instID;
+  int pinIdx;
+  bool isOutput;
+  TimingStatus status;
+  Token line;             // kept for error messages
+};
+
+// .timing file and its parse phase records
+struct TimingFile {
+  InputFile file;
+  std::vector<TimingRecord> pins;
+  double seconds;         // time spent in both phases
+
+  TimingFile() : seconds(0.0) {}
+};
+
+// parse phase: turn the lines into raw records, no design lookups
+static void parseTimingFile(TimingFile& timingFile) {
+  auto startTime = std::chrono::steady_clock::now();
+  LineScanner scanner(timingFile.file);
+  const char* lineBegin;
+  const char* lineEnd;
+  while (scanner.nextLine(lineBegin, lineEnd)) {
+    if (lineBegin == lineEnd || lineBegin[0] == '#') {
+      continue;
     }
+    timingFile.pins.emplace_back();
+    TimingRecord& pin = timingFile.pins.back();
+    pin.instID = -1;
+    pin.pinIdx = -1;
+    pin.isOutput = false;
+    pin.line.begin = lineBegin;
+    pin.line.end = lineEnd;
 
-    if (tokens.size() != 2) {
-      std::cout << "Invalid format of " << line << std::endl;
+    // inst_2 I_1
+    Token tokens[2];
+    if (tokenizeLine(lineBegin, lineEnd, tokens, 2) != 2) {
+      pin.status = TIMING_BAD_FORMAT;
+      continue;
+    }
+    if (!parseNameID(tokens[0], pin.instID)) {
+      pin.status = TIMING_BAD_INST_NAME;
       continue;
     }
+    const Token& pinName = tokens[1];
+    const char* underscorePos = static_cast<const char*>(std::memchr(pinName.begin, '_', pinName.size()));
+    if (underscorePos == nullptr) {
+      pin.status = TIMING_NO_PIN_ID;
+      continue;
+    }
+    Token dirStr = {pinName.begin, underscorePos};
+    const char* p = underscorePos + 1;
+    if (!parseDigits(p, pinName.end, pin.pinIdx)) {
+      pin.status = TIMING_BAD_PIN_NAME;
+    } else if (dirStr.equals("I")) {
+      pin.status = TIMING_OK;
+    } else if (dirStr.equals("O")) {
+      pin.isOutput = true;
+      pin.status = TIMING_OK;
+    } else {
+      pin.status = TIMING_BAD_PIN_NAME;
+    }
+  }
+  timingFile.seconds += secondsSince(startTime);
+}
 
+// link phase: mark the pins as timing critical
+static bool linkTimingFile(TimingFile& timingFile) {
+  auto startTime = std::chrono::steady_clock::now();
+  int errCnt = 0;
+  for (const TimingRecord& pin : timingFile.pins) {
+    if (pin.status == TIMING_BAD_FORMAT) {
+      std::cout << "Invalid format of " << pin.line.str() << std::endl;
+      continue;
+    }
     Instance* instPtr = nullptr;
-    instName = tokens[0];
-    size_t underscorePos = instName.find('_');
-    if (underscorePos != std::string::npos) {
-      std::string subStr = instName.substr(underscorePos + 1);
-      // Convert the second substring to an integer
-      int instID = std::stoi(subStr);
-      if (glbInstMap.find(instID) != glbInstMap.end()) {
-        instPtr = glbInstMap[instID];
+    if (pin.status != TIMING_BAD_INST_NAME) {
+      auto instIt = glbInstMap.find(pin.instID);
+      if (instIt != glbInstMap.end()) {
+        instPtr = instIt->second;
       }
     }
-
     if (instPtr == nullptr) {
-      std::cout << "Invalid instance name format: " << instName << std::endl;
+      std::cout << "Invalid instance name format: " << lineToken(pin.line, 0).str() << std::endl;
+      errCnt++;
+      continue;
+    }
+    if (pin.status == TIMING_NO_PIN_ID) {
+      continue;
+    }
+
+    Pin targetPin;
+    if (pin.status == TIMING_BAD_PIN_NAME) {
+      std::cout << "Invalid pin name format: " << lineToken(pin.line, 1).str() << std::endl;
+      errCnt++;
+    } else if (!pin.isOutput && pin.pinIdx < instPtr->getNumInpins()) {
+      targetPin = instPtr->getInpin(pin.pinIdx);
+    } else if (pin.isOutput && pin.pinIdx < instPtr->getNumOutpins()) {
+      targetPin = instPtr->getOutpin(pin.pinIdx);
+    }
+    if (!targetPin.isValid()) {
+      std::cout << "Invalid pin name: " << lineToken(pin.line, 1).str() << std::endl;
       errCnt++;
     } else {
-      Pin* pinPtr = nullptr;
-      pinName = tokens[1];
-      underscorePos = pinName.find('_');
-      if (underscorePos != std::string::npos) {
-        std::string dirStr = pinName.substr(0, underscorePos);
-        std::string pinIDStr = pinName.substr(underscorePos + 1);
-        int pinID = std::stoi(pinIDStr);
-        if (dirStr == "I") {
-          pinPtr = instPtr->getInpin(pinID);
-        } else if (dirStr == "O") {
-          pinPtr = instPtr->getOutpin(pinID);
-        } else {
-          std::cout << "Invalid pin name format: " << pinName << std::endl;
-          errCnt++;
-        }
-        if (pinPtr == nullptr) {
-          std::cout << "Invalid pin name: " << pinName << std::endl;
-          errCnt++;
-        } else {
-          pinPtr->setTimingCritical(true);
-        }
-      } 
+      targetPin.setTimingCritical(true);
     }
-  }    
+  }
+  if (timingFile.file.hasError()) {
+    std::cout << "Failed to read file: " << timingFile.file.getName() << std::endl;
+    errCnt++;
+  }
+  timingFile.seconds += secondsSince(startTime);
 
-  inputFile.close();
-  
   if (errCnt > 0) {
     return false;
   } else {
@@ -81,110 +341,111 @@ bool readInputTiming(const std::string& fileName) {
   }    
 }
 
-bool readInputNodes(const std::string& fileName) {
+bool readInputTiming(const std::string& fileName) {
+  TimingFile timingFile;
+  if (!timingFile.file.open(fileName, false)) {
+    std::cout << "Failed to open file: " << fileName << std::endl;
+    return false;
+  }
+  parseTimingFile(timingFile);
+  bool isValid = linkTimingFile(timingFile);
+  reportThroughput(fileName, timingFile.file.getSize(), timingFile.seconds);
+  timingFile.file.reportBandwidth();
+  return isValid;
+}
+
+bool readOutputNetlist(const std::string& fileName) {
   // Implementation of readInputNetlist function
-  std::ifstream inputFile(fileName);
-  if (!inputFile.is_open()) {
+  InputFile inputFile;
+  if (!inputFile.open(fileName, false)) {
     std::cout << "Failed to open file: " << fileName << std::endl;
     return false;
   }
+  auto startTime = std::chrono::steady_clock::now();
 
-  // clear all baseline instances in all tiles 
-  for (int i = 0; i < chip.getNumCol(); i++) {
-    for (int j = 0; j < chip.getNumRow(); j++) {
-      Tile* tile = chip.getTile(i, j);
-      // new input netlist is being read, clear all existing instances in the tile
-      tile->clearInstances();   
-    }
+  // clear existing optimized instances in all tiles 
+  for (int tileIdx = 0; tileIdx < chip.getNumTiles(); tileIdx++) {
+    Tile* tile = chip.getTileByIndex(tileIdx);      
+    tile->clearOptimizedInstances();   
   }
 
-  // Parse the location string to extract the coordinates
-  std::regex locationRegex("X(\\d+)Y(\\d+)Z(\\d+)");
+  LibTable libTable = buildLibTable();
 
-  std::string line;    
+  // each line: <location> <type> <name>
+  LineScanner scanner(inputFile);
+  const char* lineBegin;
+  const char* lineEnd;
   int errCnt = 0;
-  while (std::getline(inputFile, line)) {        
-    if (line.empty() || line[0] == '#') {
+  while (scanner.nextLine(lineBegin, lineEnd)) {
+    if (lineBegin == lineEnd || lineBegin[0] == '#') {
       continue;
     }
-    std::istringstream iss(line);
-    std::string location, type, name;
-    bool isFixed = false;
-    
-    std::vector<std::string> tokens;
-    std::string token;
-    while (iss >> token) {
-      tokens.push_back(token);
-    }
-    
-    location = tokens[0];
-    type = tokens[1];
-    name = tokens[2];
-    if (tokens.size() == 4) {
-      isFixed = (tokens[3] == "FIXED");
-    } 
 
-    std::smatch match;
-    int x, y, z;
-    if (std::regex_search(location, match, locationRegex)) {
-      x = std::stoi(match[1]);
-      y = std::stoi(match[2]);
-      z = std::stoi(match[3]);
-    } else {
-      std::cout << "Error: Invalid location format: " << location << std::endl;
+    Token tokens[3];
+    int numTokens = tokenizeLine(lineBegin, lineEnd, tokens, 3);
+    if (numTokens == 0) {
+      continue;
+    }
+    if (numTokens < 3) {
+      std::cout << "Error, Invalid format of " << std::string(lineBegin, lineEnd) << std::endl;
       errCnt++;
+      continue;
     }
 
+    const Token& location = tokens[0];
+    const Token& type = tokens[1];
+    const Token& name = tokens[2];
+
     int instID = -1;
-    size_t underscorePos = name.find('_');
-    if (underscorePos != std::string::npos) {
-      std::string subStr = name.substr(underscorePos + 1);
-      // Convert the second substring to an integer
-      instID = std::stoi(subStr);
-    } else {
-      std::cout << "Error: Invalid name format: " << name << std::endl;
+    if (!parseNameID(name, instID)) {
+      std::cout << "Error, Invalid name format: " << name.str() << std::endl;
       errCnt++;
     }
-     
+
+    int x, y, z;
+    bool isValidLoc = parseLocation(location, x, y, z) && x < chip.getNumCol() && y < chip.getNumRow();
+    if (!isValidLoc) {
+      std::cout << "Error, Invalid location format: " << location.str() << std::endl;
+      errCnt++;
+    }
+
     // Check if the instance already exists in the map
-    if (glbInstMap.find(instID) != glbInstMap.end()) {
-      std::cout << "Error: Instance with name " << name << " already exists in the map." << std::endl;
+    instID = glbInstIDs.toInternal(instID);
+    auto mIt = glbInstMap.find(instID);
+    if (mIt == glbInstMap.end()) {
+      std::cout << "Error, Instance with name " << name.str() << " can not be indexed." << std::endl;
       errCnt++;
       continue; // Skip adding the instance to the map
     }
-    
-    // Find the corresponding Lib object
-    Lib* libPtr = nullptr;
-    auto libIt = glbLibMap.find(type);
-    if (libIt == glbLibMap.end()) {
-      std::cout << "Error: Library with name " << type << " not found." << std::endl;
-      errCnt++;
-      continue; 
-    } else {
-      libPtr = libIt->second;
+    if (!isValidLoc) {
+      continue;
     }
-
     // Add the new instance object to the instMap
-    Instance* newInstance = new Instance();
-    newInstance->setInstanceName(name);
-    newInstance->setModelName(type);
-    newInstance->setBaseLocation(std::make_tuple(x, y, z));
-    newInstance->setFixed(isFixed);
-    newInstance->setCellLib(libPtr);
-    glbInstMap[instID] = newInstance;
+    mIt->second->setLocation(std::make_tuple(x, y, z));
 
-    // add the instance to the corresponding tile
+    // add optimized coordinate, the type in the file is checked against the tile
     Tile* tilePtr = chip.getTile(x, y);
-    if (tilePtr != nullptr) {
-      // add baseline coordinate
-      if (tilePtr->addInstance(instID, z, type, true) == false) {
-        std::cout << "Error: Failed to add baseline coordinate for instance " << name << std::endl;
-        return false;
-      } 
-    }
+    Lib* libPtr = findLib(libTable, type);
+    bool isAdded = libPtr != nullptr ? tilePtr->addInstance(instID, z, libPtr, false)
+                                     : tilePtr->addInstance(instID, z, type.str(), false);
+    if (isAdded == false) {
+      std::cout << "Error: Failed to add optimized coordinate for instance " << name.str() << std::endl;
+      return false;
+    } 
   }
+
+  if (inputFile.hasError()) {
+    std::cout << "Failed to read file: " << fileName << std::endl;
+    errCnt++;
+  }
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+  reportThroughput(fileName, inputFile.getSize(), elapsed.count());
+  inputFile.reportBandwidth();
   inputFile.close();
 
+  errCnt += reportPlacementStatistics();
+
   if (errCnt > 0) {
     return false;
   } else {
@@ -192,97 +453,214 @@ bool readInputNodes(const std::string& fileName) {
   }
 }
 
-bool readOutputNetlist(const std::string& fileName) {
-  // Implementation of readInputNetlist function
-  std::ifstream inputFile(fileName);
-  if (!inputFile.is_open()) {
-    std::cout << "Failed to open file: " << fileName << std::endl;
-    return false;
-  }
+// optimized slot occupation keyed by <col, row, slot kind, slot index>,
+// instances of a slot are sorted so the insertion order does not matter
+typedef std::map<std::tuple<int, int, int, int>, std::vector<int> > SlotOccupation;
 
-  // clear existing optimized instances in all tiles 
-  for (int i = 0; i < chip.getNumCol(); i++) {
-    for (int j = 0; j < chip.getNumRow(); j++) {
-      Tile* tile = chip.getTile(i, j);      
-      tile->clearOptimizedInstances();   
+static void collectOptimizedOccupation(SlotOccupation& occupation) {
+  for (int tileIdx = 0; tileIdx < chip.getNumTiles(); tileIdx++) {
+    Tile* tile = chip.getTileByIndex(tileIdx);
+    for (int kind = 0; kind < NUM_SLOT_KINDS; kind++) {
+      const Slot* slots = tile->getSlots((SlotKind)kind);
+      if (slots == nullptr) {
+        continue;
+      }
+      for (int idx = 0; idx < slotCapacity[kind]; idx++) {
+        const SlotInstances& instArr = slots[idx].getOptimizedInstances();
+        if (instArr.empty()) {
+          continue;
+        }
+        std::vector<int>& instIDs = occupation[std::make_tuple(tile->getCol(), tile->getRow(), kind, idx)];
+        instIDs.assign(instArr.begin(), instArr.end());
+        std::sort(instIDs.begin(), instIDs.end());
+      }
     }
   }
+}
 
-  // Parse the location string to extract the coordinates
-  std::regex locationRegex("X(\\d+)Y(\\d+)Z(\\d+)");
+// rebuild the optimized placement from Instance::location as a full reload
+// would do, and compare it with the incrementally updated slots
+static bool validateOptimizedPlacement() {
+  SlotOccupation incremental;
+  collectOptimizedOccupation(incremental);
+  std::vector<std::pair<int, SlotRef> > incrementalRefs;
+  for (const auto& pair : glbInstMap) {
+    incrementalRefs.emplace_back(pair.first, glbOptimizedPlacement.getSlotRef(pair.first));
+  }
 
-  std::string line;
-  int errCnt = 0;
-  while (std::getline(inputFile, line)) {
-    //lineCnt++;
-    if (line.empty() || line[0] == '#') {
+  for (int tileIdx = 0; tileIdx < chip.getNumTiles(); tileIdx++) {
+    chip.getTileByIndex(tileIdx)->clearOptimizedInstances();
+  }
+  for (const auto& pair : glbInstMap) {
+    Instance* instance = pair.second;
+    if (!instance->isPlaced()) {
       continue;
     }
+    std::tuple<int, int, int> loc = instance->getLocation();
+    Tile* tilePtr = chip.getTile(std::get<0>(loc), std::get<1>(loc));
+    tilePtr->addInstance(pair.first, std::get<2>(loc), instance->getCellLib(), false);
+  }
 
-    std::istringstream iss(line);
-
-    std::vector<std::string> tokens;
-    std::string token;
-    while (iss >> token) {
-      tokens.push_back(token);
+  int numRefDiff = 0;
+  for (const auto& entry : incrementalRefs) {
+    const SlotRef& ref = glbOptimizedPlacement.getSlotRef(entry.first);
+    const SlotRef& oldRef = entry.second;
+    if (ref.tileIdx != oldRef.tileIdx || (ref.tileIdx >= 0 && (ref.kind != oldRef.kind || ref.offset != oldRef.offset))) {
+      std::cout << "Error: slot ref of inst_" << glbInstIDs.toExternal(entry.first) << " differs from a full reload" << std::endl;
+      numRefDiff++;
     }
-    
-    std::string location = tokens[0];
-    std::string type = tokens[1];
-    std::string name = tokens[2];
+  }
 
-    int instID = -1;
-    size_t underscorePos = name.find('_');
-    if (underscorePos != std::string::npos) {
-      std::string subStr = name.substr(underscorePos + 1);
-      // Convert the second substring to an integer
-      instID = std::stoi(subStr);
+  SlotOccupation reloaded;
+  collectOptimizedOccupation(reloaded);
+  if (incremental == reloaded && numRefDiff == 0) {
+    std::cout << "  Incremental placement matches a full reload." << std::endl;
+    return true;
+  }
+
+  int numDiff = 0;
+  auto incIt = incremental.begin();
+  auto relIt = reloaded.begin();
+  while (incIt != incremental.end() || relIt != reloaded.end()) {
+    const SlotOccupation::key_type* key;
+    if (relIt == reloaded.end() || (incIt != incremental.end() && incIt->first < relIt->first)) {
+      key = &incIt->first;
+      incIt++;
+    } else if (incIt == incremental.end() || relIt->first < incIt->first) {
+      key = &relIt->first;
+      relIt++;
     } else {
-      std::cout << "Error, Invalid name format: " << name << std::endl;
+      bool isSame = incIt->second == relIt->second;
+      key = &incIt->first;
+      incIt++;
+      relIt++;
+      if (isSame) {
+        continue;
+      }
+    }
+    std::cout << "Error: X" << std::get<0>(*key) << "Y" << std::get<1>(*key) << " " << slotKindNames[std::get<2>(*key)]
+              << " slot " << std::get<3>(*key) << " differs from a full reload" << std::endl;
+    numDiff++;
+  }
+  std::cout << "  Incremental placement differs from a full reload in " << numDiff << " slots and "
+            << numRefDiff << " slot refs." << std::endl;
+  return false;
+}
+
+bool readOutputDelta(const std::string& fileName, bool validate) {
+  InputFile inputFile;
+  if (!inputFile.open(fileName, false)) {
+    std::cout << "Failed to open file: " << fileName << std::endl;
+    return false;
+  }
+  auto startTime = std::chrono::steady_clock::now();
+
+  LibTable libTable = buildLibTable();
+
+  // each line: <new location> <type> <name>, only moved instances are listed
+  LineScanner scanner(inputFile);
+  const char* lineBegin;
+  const char* lineEnd;
+  int errCnt = 0;
+  int moveCnt = 0;
+  while (scanner.nextLine(lineBegin, lineEnd)) {
+    if (lineBegin == lineEnd || lineBegin[0] == '#') {
+      continue;
+    }
+
+    Token tokens[3];
+    int numTokens = tokenizeLine(lineBegin, lineEnd, tokens, 3);
+    if (numTokens == 0) {
+      continue;
+    }
+    if (numTokens < 3) {
+      std::cout << "Error, Invalid format of " << std::string(lineBegin, lineEnd) << std::endl;
       errCnt++;
+      continue;
     }
 
-    std::smatch match;
+    const Token& location = tokens[0];
+    const Token& type = tokens[1];
+    const Token& name = tokens[2];
+
+    int instID = -1;
     int x, y, z;
-    if (std::regex_search(location, match, locationRegex)) {
-      x = std::stoi(match[1]);
-      y = std::stoi(match[2]);
-      z = std::stoi(match[3]);
-    } else {
-      std::cout << "Error, Invalid location format: " << location << std::endl;
+    if (!parseNameID(name, instID)) {
+      std::cout << "Error, Invalid name format: " << name.str() << std::endl;
       errCnt++;
+      continue;
     }
-
-    // Check if the instance already exists in the map
+    if (!parseLocation(location, x, y, z) || x >= chip.getNumCol() || y >= chip.getNumRow()) {
+      std::cout << "Error, Invalid location format: " << location.str() << std::endl;
+      errCnt++;
+      continue;
+    }
+    instID = glbInstIDs.toInternal(instID);
     auto mIt = glbInstMap.find(instID);
     if (mIt == glbInstMap.end()) {
-      std::cout << "Error, Instance with name " << name << " can not be indexed." << std::endl;
+      std::cout << "Error, Instance with name " << name.str() << " can not be indexed." << std::endl;
       errCnt++;
-      continue; // Skip adding the instance to the map
+      continue;
+    }
+    Instance* instance = mIt->second;
+
+    // take the instance out of the slot it is in now
+    const SlotRef& oldSlot = glbOptimizedPlacement.getSlotRef(instID);
+    if (oldSlot.tileIdx >= 0) {
+      Tile* oldTile = chip.getTileByIndex(oldSlot.tileIdx);
+      oldTile->removeInstance(instID, (SlotKind)oldSlot.kind, oldSlot.offset, false);
     }
-    // Add the new instance object to the instMap
-    mIt->second->setLocation(std::make_tuple(x, y, z));
 
+    instance->setLocation(std::make_tuple(x, y, z));
+    Lib* libPtr = findLib(libTable, type);
     Tile* tilePtr = chip.getTile(x, y);
-    if (tilePtr != nullptr) {
-      // add optimized coordinate
-      if (tilePtr->addInstance(instID, z, type, false) == false) {
-        std::cout << "Error: Failed to add optimized coordinate for instance " << name << std::endl;
-        return false;
-      } 
+    bool isAdded = libPtr != nullptr ? tilePtr->addInstance(instID, z, libPtr, false)
+                                     : tilePtr->addInstance(instID, z, type.str(), false);
+    if (isAdded == false) {
+      std::cout << "Error: Failed to add optimized coordinate for instance " << name.str() << std::endl;
+      return false;
+    }
+    if (instance->isFixed() && instance->isMoved()) {
+      std::cout << "Error: fixed instance " << instance->getInstanceName() << " is moved." << std::endl;
+      errCnt++;
     }
+    moveCnt++;
   }
+
+  if (inputFile.hasError()) {
+    std::cout << "Failed to read file: " << fileName << std::endl;
+    errCnt++;
+  }
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+  reportThroughput(fileName, inputFile.getSize(), elapsed.count());
+  inputFile.reportBandwidth();
   inputFile.close();
+  std::cout << "  Updated " << moveCnt << " instances." << std::endl;
+
+  if (validate && !validateOptimizedPlacement()) {
+    errCnt++;
+  }
 
+  if (errCnt > 0) {
+    return false;
+  } else {
+    return true;
+  }
+}
+
+int reportPlacementStatistics() {
+  int errCnt = 0;
   int totalCnt = glbInstMap.size();
   int fixedCnt = 0;
   int movableCnt = 0;
   int replacedFixedCnt = 0;
   int replacedMovableCnt = 0;
+  std::vector<std::pair<int, std::string> > errors;   // by external ID, reported in file order
   for (const auto& pair : glbInstMap) {
     Instance* instance = pair.second;
     if (!instance->isPlaced()) {
-      std::cout << "Error: instance " << instance->getInstanceName() << " is un-placed." << std::endl;
+      errors.emplace_back(glbInstIDs.toExternal(pair.first), "Error: instance " + instance->getInstanceName() + " is un-placed.");
       errCnt++;
       continue;
     }    
@@ -290,7 +668,7 @@ bool readOutputNetlist(const std::string& fileName) {
     if (instance->isFixed()) {
       fixedCnt++;
       if (instance->isMoved()) {
-        std::cout << "Error: fixed instance " << instance->getInstanceName() << " is moved." << std::endl;
+        errors.emplace_back(glbInstIDs.toExternal(pair.first), "Error: fixed instance " + instance->getInstanceName() + " is moved.");
         replacedFixedCnt++;
         errCnt++;
       } 
@@ -302,6 +680,11 @@ bool readOutputNetlist(const std::string& fileName) {
     }    
   }
 
+  std::sort(errors.begin(), errors.end());
+  for (const auto& error : errors) {
+    std::cout << error.second << std::endl;
+  }
+
   // Print table
   std::cout << "\n  Instance Statistics:\n";
   std::cout << "  -----------------------------------------------\n";
@@ -316,92 +699,403 @@ bool readOutputNetlist(const std::string& fileName) {
             << (movableCnt > 0 ? (100.0 * replacedMovableCnt / movableCnt) : 0.0) << "% \n";
   std::cout << "  -----------------------------------------------\n";
 
-  if (errCnt > 0) {
-    return false;
+  return errCnt;
+}
+
+// parse phase record of one connection line "<inst> <pin>"
+enum NetConnStatus {
+  CONN_OK,
+  CONN_BAD_FORMAT,      // not exactly two tokens
+  CONN_BAD_INST_NAME,   // instance name without ID
+  CONN_NO_PIN_ID,       // pin name without '_', ignored
+  CONN_BAD_PIN_NAME     // pin direction is not I/O
+};
+
+struct NetConnRecord {
+  int instID;
+  int pinIdx;
+  bool isOutput;
+  NetConnStatus status;
+  Token line;           // kept for error messages
+};
+
+// parse phase record of one net block
+struct NetRecord {
+  int netID;            // -1 if the name has no ID
+  bool clock;
+  bool validName;
+  bool validHeader;
+  unsigned int numPins;
+  Token header;
+  Token name;
+  size_t connBegin;     // range in NetChunk::conns
+  size_t connEnd;
+};
+
+// a slice of the .nets file starting at a "net" line
+struct NetChunk {
+  const char* begin;
+  const char* end;
+  std::vector<NetRecord> nets;
+  std::vector<NetConnRecord> conns;
+  std::vector<Net*> linkedNets;   // per record, nullptr if the net is dropped
+  std::vector<std::pair<size_t, size_t> > sinkRanges;   // per record, range in sinks
+  std::vector<Pin> sinks;         // sink pins of the linked nets, net by net
+  ObjectArena<Net> arena;         // owner of linkedNets until the chunk is merged
+  std::vector<std::pair<Pin, int> > pinNets;   // pin net IDs to set, in file order
+  std::ostringstream log;         // messages in file order
+  int numErr;
+
+  NetChunk() : begin(nullptr), end(nullptr), numErr(0) {}
+};
+
+static bool isNetLine(const char* lineBegin, const char* lineEnd) {
+  return lineEnd - lineBegin >= 3 && std::memcmp(lineBegin, "net", 3) == 0;
+}
+
+static bool isEndNetLine(const char* lineBegin, const char* lineEnd) {
+  return lineEnd - lineBegin >= 6 && std::memcmp(lineBegin, "endnet", 6) == 0;
+}
+
+// hand out slices of about chunkSize bytes, each one starting at a "net" line,
+// as soon as the loader has read past their end
+static void splitNetFile(const InputFile& file, size_t chunkSize,
+                         const std::function<void(const char*, const char*)>& addChunk) {
+  const char* chunkBegin = file.begin();
+  while (true) {
+    const char* target = chunkBegin + chunkSize;
+    const char* chunkEnd = nullptr;
+    if (file.waitBeyond(target) > target) {
+      // skip the rest of the line the target is in, then move to the next net
+      LineScanner scanner(file, target);
+      const char* lineBegin;
+      const char* lineEnd;
+      scanner.nextLine(lineBegin, lineEnd);
+      while (scanner.nextLine(lineBegin, lineEnd)) {
+        if (isNetLine(lineBegin, lineEnd)) {
+          chunkEnd = lineBegin;
+          break;
+        }
+      }
+    }
+    if (chunkEnd == nullptr) {
+      // no net after the target, the loader is done and the rest is the last slice
+      addChunk(chunkBegin, file.waitBeyond(target));
+      return;
+    }
+    addChunk(chunkBegin, chunkEnd);
+    chunkBegin = chunkEnd;
+  }
+}
+
+static void parseNetConn(const char* lineBegin, const char* lineEnd, NetConnRecord& conn) {
+  conn.instID = -1;
+  conn.pinIdx = -1;
+  conn.isOutput = false;
+  conn.line.begin = lineBegin;
+  conn.line.end = lineEnd;
+
+  // inst_2 I_1
+  Token tokens[2];
+  if (tokenizeLine(lineBegin, lineEnd, tokens, 2) != 2) {
+    conn.status = CONN_BAD_FORMAT;
+    return;
+  }
+  if (!parseNameID(tokens[0], conn.instID)) {
+    conn.status = CONN_BAD_INST_NAME;
+    return;
+  }
+
+  const Token& pinName = tokens[1];
+  const char* underscorePos = static_cast<const char*>(std::memchr(pinName.begin, '_', pinName.size()));
+  if (underscorePos == nullptr) {
+    conn.status = CONN_NO_PIN_ID;
+    return;
+  }
+  Token dirStr = {pinName.begin, underscorePos};
+  const char* p = underscorePos + 1;
+  if (!parseDigits(p, pinName.end, conn.pinIdx)) {
+    conn.status = CONN_BAD_PIN_NAME;
+  } else if (dirStr.equals("I")) {
+    conn.status = CONN_OK;
+  } else if (dirStr.equals("O")) {
+    conn.isOutput = true;
+    conn.status = CONN_OK;
   } else {
-    return true;
+    conn.status = CONN_BAD_PIN_NAME;
   }
 }
 
-bool readInputNets(const std::string& fileName) {
-  std::ifstream inputFile(fileName);
-  if (!inputFile.is_open()) {
-    std::cout << "Failed to open file: " << fileName << std::endl;
-    return false;
+static void parseNetHeader(const char* lineBegin, const char* lineEnd, NetRecord& net) {
+  net.netID = -1;
+  net.clock = false;
+  net.validName = false;
+  net.validHeader = false;
+  net.numPins = 0;
+  net.header.begin = lineBegin;
+  net.header.end = lineEnd;
+
+  // net <name> <num_pins> [clock]
+  Token tokens[3];
+  int numTokens = 0;
+  if (lineEnd - lineBegin > 4) {
+    numTokens = tokenizeLine(lineBegin + 4, lineEnd, tokens, 3);
   }
+  if (numTokens < 2) {
+    return;
+  }
+  net.name = tokens[0];
+  net.validName = parseNameID(net.name, net.netID);
+  if (!net.validName) {
+    net.netID = -1;
+  }
+  int numPins = 0;
+  const char* p = tokens[1].begin;
+  if (!parseDigits(p, tokens[1].end, numPins)) {
+    return;
+  }
+  net.numPins = numPins;
+  net.validHeader = true;
+  if (numTokens == 3 && tokens[2].equals("clock")) {
+    net.clock = true;
+  }
+}
 
-  int numErr = 0;
-  std::string line;
-  std::vector<std::string> netLines;
+// parse phase: turn the lines of a chunk into raw records, no design lookups
+static void parseNetChunk(NetChunk& chunk) {
+  LineScanner scanner(chunk.begin, chunk.end);
+  const char* lineBegin;
+  const char* lineEnd;
   bool isInsideNet = false;
-  std::string netInfoStr;
-
-  while (std::getline(inputFile, line)) {
-    if (line.empty() || line[0] == '#') {
+  NetRecord net;
+  while (scanner.nextLine(lineBegin, lineEnd)) {
+    if (lineBegin == lineEnd || lineBegin[0] == '#') {
       continue;
     }
-    if (line.substr(0, 3) == "net") {
+    if (isNetLine(lineBegin, lineEnd)) {
+      // an unterminated net is dropped
+      if (isInsideNet) {
+        chunk.conns.resize(net.connBegin);
+      }
       isInsideNet = true;
-      netInfoStr = line.substr(4);
-      netLines.clear();
+      parseNetHeader(lineBegin, lineEnd, net);
+      net.connBegin = chunk.conns.size();
+      continue;
     }
-    if (isInsideNet) {
-      netLines.push_back(line);
+    if (!isInsideNet) {
+      continue;
     }
-    if (line.substr(0, 6) == "endnet") {
+    if (isEndNetLine(lineBegin, lineEnd)) {
       isInsideNet = false;
+      net.connEnd = chunk.conns.size();
+      chunk.nets.push_back(net);
+      continue;
+    }
+    chunk.conns.emplace_back();
+    parseNetConn(lineBegin, lineEnd, chunk.conns.back());
+  }
+  if (isInsideNet) {
+    chunk.conns.resize(net.connBegin);
+  }
+}
 
-      std::istringstream iss(netInfoStr);
-      std::vector<std::string> tokens;
-      std::string token;
-      while (iss >> token) {
-        tokens.push_back(token);
-      }
+static bool linkNetConn(Net* net, const NetConnRecord& conn, NetChunk& chunk) {
+  std::ostream& log = chunk.log;
+  if (conn.status == CONN_BAD_FORMAT) {
+    log << "Error: Invalid connection format " << conn.line.str() << "\n";
+    return false;
+  }
+  Instance* instPtr = nullptr;
+  if (conn.status != CONN_BAD_INST_NAME) {
+    auto instIt = glbInstMap.find(conn.instID);
+    if (instIt != glbInstMap.end()) {
+      instPtr = instIt->second;
+    }
+  }
+  if (instPtr == nullptr) {
+    log << "Invalid instance name format: " << lineToken(conn.line, 0).str() << "\n";
+    return false;
+  }
 
-      std::string netNameStr = tokens[0];
-      int netID = -1;
-      size_t underscorePos = netNameStr.find('_');
-      if (underscorePos != std::string::npos) {
-        std::string subStr = netNameStr.substr(underscorePos + 1);
-        // Convert the second substring to an integer
-        netID = std::stoi(subStr);
-      } else {
-        std::cout << "Invalid name format: " << netNameStr << std::endl;
-      }
+  if (conn.status == CONN_NO_PIN_ID) {
+    return true;
+  }
+  int numPins = conn.isOutput ? instPtr->getNumOutpins() : instPtr->getNumInpins();
+  if (conn.status == CONN_BAD_PIN_NAME || conn.pinIdx >= numPins) {
+    log << "Invalid pin name format: " << lineToken(conn.line, 1).str() << "\n";
+    return false;
+  }
 
-      unsigned int numPins = std::stoi(tokens[1]);
-      if (netLines.size() != (numPins + 2)) {
-        // The first line is the net name, the last line is the ending maker
-        std::cout << "Wrong number of connections of net " << netNameStr << std::endl;
-        continue;
+  if (!conn.isOutput) {
+    Pin pin = instPtr->getInpin(conn.pinIdx);
+    chunk.pinNets.emplace_back(pin, net->getId());
+    chunk.sinks.push_back(pin);
+  } else {
+    Pin pin = instPtr->getOutpin(conn.pinIdx);
+    chunk.pinNets.emplace_back(pin, net->getId());
+    bool isValid = true;
+    if (net->getInpin().isValid()) {
+      log << "Error: Multiple drivers for net ID = " << net->getId() << "\n";
+      isValid = false;
+    }
+    net->setInpin(pin);
+    return isValid;
+  }
+  return true;
+}
+
+// link phase: resolve the records of a chunk to Instance/Pin objects
+// glbInstMap is only read here, so chunks can be linked concurrently;
+// pins are not written, their net IDs are set in file order afterwards
+static void linkNetChunk(NetChunk& chunk) {
+  chunk.linkedNets.assign(chunk.nets.size(), nullptr);
+  chunk.sinkRanges.assign(chunk.nets.size(), std::make_pair(0, 0));
+  for (unsigned int i = 0; i < chunk.nets.size(); i++) {
+    const NetRecord& net = chunk.nets[i];
+    if (!net.validHeader) {
+      chunk.log << "Invalid format of " << net.header.str() << "\n";
+      chunk.numErr++;
+      continue;
+    }
+    if (!net.validName) {
+      // nets are keyed by the ID in their name
+      chunk.log << "Invalid name format: " << net.name.str() << "\n";
+      chunk.numErr++;
+      continue;
+    }
+    if (net.netID > MAX_OBJECT_ID) {
+      chunk.log << "Error: ID of net " << net.name.str() << " is larger than " << MAX_OBJECT_ID << "\n";
+      chunk.numErr++;
+      continue;
+    }
+    if (net.connEnd - net.connBegin != net.numPins) {
+      // The first line is the net name, the last line is the ending maker
+      chunk.log << "Wrong number of connections of net " << net.name.str() << "\n";
+      continue;
+    }
+
+    // Create a new Net object
+    Net* newNet = chunk.arena.create(net.netID);
+    size_t sinkBegin = chunk.sinks.size();
+    for (size_t idx = net.connBegin; idx < net.connEnd; idx++) {
+      if (linkNetConn(newNet, chunk.conns[idx], chunk) == false) {
+        chunk.numErr++;
       }
+    }
+    newNet->setClock(net.clock);
+    chunk.linkedNets[i] = newNet;
+    chunk.sinkRanges[i] = std::make_pair(sinkBegin, chunk.sinks.size());
+  }
+}
 
-      // Create a new Net object
-      Net* newNet = new Net(netID);
-      unsigned int idx = 0;
-      for (auto conn : netLines) {
-        if (idx == 0 || idx == netLines.size() - 1) {
-          // skip starting and ending lines 
-          idx++;
-          continue;
+// .nets file and its parse phase records
+struct NetFile {
+  InputFile file;
+  std::deque<NetChunk> chunks;   // grows while earlier chunks are parsed
+  double seconds;         // time spent in both phases
+
+  NetFile() : seconds(0.0) {}
+};
+
+static void parseNetFile(NetFile& netFile) {
+  auto startTime = std::chrono::steady_clock::now();
+
+  // chunks are split while the file loads and parsed by the workers as soon
+  // as they are complete; a few chunks per thread even out the load. The
+  // calling thread is one of the glbNumThreads workers: it splits the file
+  // and then parses with the others, or parses each chunk as it is split
+  // when it is the only one
+  std::deque<NetChunk>& chunks = netFile.chunks;
+  std::mutex mutex;
+  std::condition_variable cond;
+  size_t nextChunk = 0;
+  bool isSplit = false;
+  auto parseChunks = [&](bool wait) {
+    while (true) {
+      NetChunk* chunk;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (wait) {
+          cond.wait(lock, [&]() { return nextChunk < chunks.size() || isSplit; });
         }
-        if (newNet->addConnection(conn) == false) {
-          numErr++;
+        if (nextChunk == chunks.size()) {
+          return;
         }
-        idx++;
+        chunk = &chunks[nextChunk++];
       }
-      if (tokens.size() == 3) {
-        std::string clockStr = tokens[2];
-        if (clockStr == "clock") {
-          newNet->setClock(true);
-        }
-      } 
-     
-      // Add the new Net object to the netMap
-      glbNetMap[netID] = newNet;
+      parseNetChunk(*chunk);
     }
+  };
+  std::vector<std::thread> workers;
+  for (int i = 1; i < glbNumThreads; i++) {
+    workers.emplace_back(parseChunks, true);
   }
-  inputFile.close();
+
+  int numChunks = glbNumThreads > 1 ? glbNumThreads * 4 : 1;
+  size_t chunkSize = std::min((size_t)IO_BLOCK_SIZE, std::max(netFile.file.getCapacity() / numChunks, (size_t)1));
+  splitNetFile(netFile.file, chunkSize, [&](const char* begin, const char* end) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      chunks.emplace_back();
+      chunks.back().begin = begin;
+      chunks.back().end = end;
+    }
+    if (workers.empty()) {
+      parseChunks(false);
+    } else {
+      cond.notify_one();
+    }
+  });
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    isSplit = true;
+  }
+  cond.notify_all();
+  parseChunks(true);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  netFile.seconds += secondsSince(startTime);
+}
+
+static bool linkNetFile(NetFile& netFile) {
+  auto startTime = std::chrono::steady_clock::now();
+  if (netFile.file.hasError()) {
+    std::cout << "Failed to read file: " << netFile.file.getName() << std::endl;
+    return false;
+  }
+  std::deque<NetChunk>& chunks = netFile.chunks;
+  runParallel(chunks.size(), glbNumThreads, [&](int i) { linkNetChunk(chunks[i]); });
+
+  // Add the new Net objects to the netMap in file order,
+  // their sinks are laid out in glbNetSinks in the same order
+  size_t numRows = 0;
+  size_t numSinks = 0;
+  for (auto& chunk : chunks) {
+    numRows += chunk.linkedNets.size();
+    numSinks += chunk.sinks.size();
+  }
+  glbNetSinks.reserve(numRows, numSinks);
+
+  int numErr = 0;
+  for (auto& chunk : chunks) {
+    std::cout << chunk.log.str();
+    numErr += chunk.numErr;
+    for (unsigned int i = 0; i < chunk.linkedNets.size(); i++) {
+      Net* net = chunk.linkedNets[i];
+      if (net != nullptr) {
+        const Pin* sinks = chunk.sinks.data();
+        net->setSinkRow(glbNetSinks.addRow(sinks + chunk.sinkRanges[i].first, sinks + chunk.sinkRanges[i].second));
+        glbNetMap[net->getId()] = net;
+      }
+    }
+    glbNetArena.splice(chunk.arena);
+    // a pin listed on several nets keeps the last one, as in a serial read
+    for (auto& pinNet : chunk.pinNets) {
+      pinNet.first.setNetID(pinNet.second);
+    }
+  }
+  netFile.seconds += secondsSince(startTime);
 
   if (numErr > 0 ) {
     return false;
@@ -410,13 +1104,93 @@ bool readInputNets(const std::string& fileName) {
   }
 }
 
+bool readInputNets(const std::string& fileName) {
+  NetFile netFile;
+  if (!netFile.file.open(fileName, false)) {
+    std::cout << "Failed to open file: " << fileName << std::endl;
+    return false;
+  }
+  parseNetFile(netFile);
+  bool isValid = linkNetFile(netFile);
+  reportThroughput(fileName, netFile.file.getSize(), netFile.seconds);
+  netFile.file.reportBandwidth();
+  return isValid;
+}
+
+bool readDesign(const std::string& nodeFileName, const std::string& netFileName, const std::string& timingFileName) {
+  NodeFile nodeFile;
+  NetFile netFile;
+  TimingFile timingFile;
+  bool isOpen = true;
+  if (!nodeFile.file.open(nodeFileName, false)) {
+    std::cout << "Failed to open file: " << nodeFileName << std::endl;
+    isOpen = false;
+  }
+  if (!netFile.file.open(netFileName, false)) {
+    std::cout << "Failed to open file: " << netFileName << std::endl;
+    isOpen = false;
+  }
+  if (!timingFile.file.open(timingFileName, false)) {
+    std::cout << "Failed to open file: " << timingFileName << std::endl;
+    isOpen = false;
+  }
+  if (!isOpen) {
+    return false;
+  }
+
+  // the three files are loading in the background by now; the parse phases
+  // only read glbLibMap, so each file is tokenized on its own thread while
+  // it loads, whatever the number of threads; the nets split their chunks
+  // over the glbNumThreads workers
+  std::thread nodeThread([&]() { parseNodeFile(nodeFile); });
+  std::thread timingThread([&]() { parseTimingFile(timingFile); });
+  parseNetFile(netFile);
+  nodeThread.join();
+  timingThread.join();
+
+  // nets and timing pins resolve instance names, the instances go first
+  bool isValid = true;
+  if (!linkNodeFile(nodeFile)) {
+    isValid = false;
+  }
+  if (!linkNetFile(netFile)) {
+    isValid = false;
+  }
+  if (!linkTimingFile(timingFile)) {
+    isValid = false;
+  }
+
+  reportThroughput(nodeFileName, nodeFile.file.getSize(), nodeFile.seconds);
+  reportThroughput(netFileName, netFile.file.getSize(), netFile.seconds);
+  reportThroughput(timingFileName, timingFile.file.getSize(), timingFile.seconds);
+  nodeFile.file.reportBandwidth();
+  netFile.file.reportBandwidth();
+  timingFile.file.reportBandwidth();
+  return isValid;
+}
+
+void resetDesign() {
+  // the tiles go first, emptying a slot resets the slot refs of its instances
+  chip.clearDesign();
+  // objects are released with their arenas
+  glbInstMap.clear();
+  glbNetMap.clear();
+  glbPinStore.clear();
+  glbNetSinks.clear();
+  glbBaselinePlacement.clear();
+  glbOptimizedPlacement.clear();
+  glbInstIDs.clear();
+  glbNetIDs.clear();
+  glbInstArena.clear();
+  glbNetArena.clear();
+}
+
 bool reportDesignStatistics() {
   std::cout << "  Number of instances: " << glbInstMap.size() << std::endl;
 
   std::map<std::string, std::pair<int,int> > countByType;  // <total_cnt, fixed_cnt>
   for (auto inst : glbInstMap) {
-    std::string modelName = inst.second->getModelName();
-    modelName = unifyModelType(modelName);
+    const std::string& modelName = inst.second->getCellLib()->getSlotType();
     if (countByType.find(modelName) == countByType.end()) {
       if (inst.second->isFixed()) {
         countByType[modelName] = std::make_pair(1, 1);
@@ -483,12 +1257,11 @@ bool reportDesignStatistics() {
       numClkNet++;
     }
 
-    if (net.second->getInpin()->getTimingCritical()) {
+    if (net.second->getInpin().isValid() && net.second->getInpin().getTimingCritical()) {
       numTotalCriticalPin++;
     }
-    std::list<Pin*> netOutPins = net.second->getOutputPins();
-    for (auto oPin : netOutPins) {
-      if (oPin->getTimingCritical()) {
+    for (const Pin& oPin : net.second->getOutputPins()) {
+      if (oPin.getTimingCritical()) {
         numTotalCriticalPin++;
       }
     }
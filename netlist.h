@@ -3,12 +3,24 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
-#include <regex>
 
 
 bool readInputNodes(const std::string& fileName);
 bool readInputNets(const std::string& fileName);
 bool readOutputNetlist(const std::string& fileName);
+// apply the moved instances listed in fileName to the loaded optimized placement;
+// with validate, the result is compared with a full reload of the placement
+bool readOutputDelta(const std::string& fileName, bool validate);
+// check the optimized placement against the baseline after a placement load,
+// print the re-placed instance table and return the number of errors
+int reportPlacementStatistics();
 bool readInputTiming(const std::string& fileName);
 
+// read_design: the three files are parsed concurrently into records,
+// then linked to the design in order nodes, nets, timing
+bool readDesign(const std::string& nodeFileName, const std::string& netFileName, const std::string& timingFileName);
+
 bool reportDesignStatistics();
+
+// drop the loaded design, the libraries and the architecture are kept
+void resetDesign();
@@ -2,22 +2,64 @@
 #include <sstream>
 #include <iomanip>
 #include <set>
+#include <algorithm>
 #include "global.h"
 #include "object.h"
 #include "rsmt.h"
 #include "util.h"
 
-Tile::~Tile() {
-  for (auto& pair : instanceMap) {
-    for (auto& slot : pair.second) {
-      delete slot;
+void SlotInstances::push_back(int instID) {
+  if (count < SLOT_INLINE_INSTANCES) {
+    inlineIDs[count++] = instID;
+    return;
+  }
+  if (count == SLOT_INLINE_INSTANCES) {
+    spilled.assign(inlineIDs, inlineIDs + count);
+  }
+  spilled.push_back(instID);
+  count++;
+}
+
+void SlotInstances::remove(int instID) {
+  int* ids = count > SLOT_INLINE_INSTANCES ? spilled.data() : inlineIDs;
+  int newCount = std::remove(ids, ids + count, instID) - ids;
+  if (count > SLOT_INLINE_INSTANCES) {
+    if (newCount <= SLOT_INLINE_INSTANCES) {
+      std::copy(ids, ids + newCount, inlineIDs);
+      spilled.clear();
+    } else {
+      spilled.resize(newCount);
+    }
+  }
+  count = newCount;
+}
+
+void SlotInstances::renumber(const std::vector<int>& newIDs) {
+  int* ids = count > SLOT_INLINE_INSTANCES ? spilled.data() : inlineIDs;
+  for (int i = 0; i < count; i++) {
+    ids[i] = newIDs[ids[i]];
+  }
+}
+
+SlotKind getSlotKind(const std::string& slotType) {
+  for (int kind = 0; kind < NUM_SLOT_KINDS; kind++) {
+    if (slotType == slotKindNames[kind]) {
+      return (SlotKind)kind;
+    }
+  }
+  return NUM_SLOT_KINDS;
+}
+
+TileType getTileType(const std::string& tileType) {
+  for (int type = 0; type < NUM_TILE_TYPES; type++) {
+    if (tileType == tileTypeNames[type]) {
+      return (TileType)type;
     }
   }
-  instanceMap.clear();
+  return NUM_TILE_TYPES;
 }
 
-bool Tile::matchType(const std::string& modelType) {  
-  std::string matchType = modelType;
+TileTypeMask getModelTileMask(const std::string& modelType) {
   if ( modelType == "SEQ"   ||
       modelType == "LUT6"   || 
       modelType == "LUT5"   || 
@@ -30,75 +72,118 @@ bool Tile::matchType(const std::string& modelType) {
       modelType == "CARRY4" ||
       modelType == "F7MUX"  ||
       modelType == "F8MUX" ) {
-    matchType = "PLB";        
+    return tileTypeBit(TILE_PLB);
   }
-  return tileTypes.find(matchType) != tileTypes.end();
+  TileType type = getTileType(modelType);
+  return type == NUM_TILE_TYPES ? 0 : tileTypeBit(type);
 }
 
-bool Tile::addInstance(int instID, int offset, std::string modelType, const bool isBaseline) {
-  if (matchType(modelType) == false) {        
-    std::cout << "Error: " << getLocStr() << " " << modelType <<" instance " << instID << ", type mismatch with tile type" << std::endl;
+bool Tile::addInstance(int instID, int offset, const std::string& modelType, const bool isBaseline) {
+  auto libIt = glbLibMap.find(modelType);
+  if (libIt == glbLibMap.end()) {
+    std::cout << "Error: " << getLocStr() << " " << modelType <<" instance " << glbInstIDs.toExternal(instID) << ", type mismatch with tile type" << std::endl;
     return false;
   }
+  return addInstance(instID, offset, libIt->second, isBaseline);
+}
 
-  std::string mtp = unifyModelType(modelType);
+bool Tile::addInstance(int instID, int offset, const Lib* lib, const bool isBaseline) {
+  if (matchType(lib->getTileMask()) == false) {        
+    std::cout << "Error: " << getLocStr() << " " << lib->getName() <<" instance " << glbInstIDs.toExternal(instID) << ", type mismatch with tile type" << std::endl;
+    return false;
+  }
 
-  auto mapIter = instanceMap.find(mtp);
-  if (mapIter == instanceMap.end()) {
-    std::cout << "Error: Invalid slot type " << mtp << " @ " << getLocStr() << std::endl;
+  SlotKind kind = lib->getSlotKind();
+  if (!hasSlots(kind)) {
+    std::cout << "Error: Invalid slot type " << lib->getSlotType() << " @ " << getLocStr() << std::endl;
     return false;
   }
 
-  if (offset >= (int)mapIter->second.size()) {
-    std::cout << "Error: " << mtp << " slot offset " << offset << " exceeds the capacity" << std::endl;
+  if (offset < 0 || offset >= slotCapacity[kind]) {
+    std::cout << "Error: " << lib->getSlotType() << " slot offset " << offset << " exceeds the capacity" << std::endl;
     return false;
   }
 
+  Slot& slot = slotBegin[kind] == SLOT_LAZY ? allocSlots(kind)[offset] : slots[slotBegin[kind] + offset];
   if (isBaseline){
-    mapIter->second[offset]->addBaselineInstance(instID);
+    slot.addBaselineInstance(instID);
   } else {
-    mapIter->second[offset]->addOptimizedInstance(instID);
+    slot.addOptimizedInstance(instID);
   }
+  PlacementStore& placement = isBaseline ? glbBaselinePlacement : glbOptimizedPlacement;
+  placement.setSlotRef(instID, chip.getTileIndex(col, row), kind, offset);
   return true;
 }
 
-void Tile::clearInstances() {
-  for (auto& pair : instanceMap) {
-    for (auto& slot : pair.second) {
-      slot->clearInstances();
-    }
+bool Tile::removeInstance(int instID, SlotKind kind, int offset, const bool isBaseline) {
+  if (!hasSlots(kind) || offset < 0 || offset >= slotCapacity[kind]) {
+    return false;
+  }
+  if (slotBegin[kind] == SLOT_LAZY) {
+    return true;   // nothing was added
+  }
+
+  Slot& slot = slots[slotBegin[kind] + offset];
+  if (isBaseline){
+    slot.removeBaselineInstance(instID);
+  } else {
+    slot.removeOptimizedInstance(instID);
+  }
+
+  // the instance may have been added to another slot after this one
+  PlacementStore& placement = isBaseline ? glbBaselinePlacement : glbOptimizedPlacement;
+  const SlotRef& ref = placement.getSlotRef(instID);
+  if (ref.tileIdx == chip.getTileIndex(col, row) && ref.kind == kind && ref.offset == offset) {
+    placement.clearSlotRef(instID);
   }
+  return true;
+}
+
+void Tile::clearInstances() {
+  clearBaselineInstances();
+  clearOptimizedInstances();
 }
 
 void Tile::clearBaselineInstances() {
-  for (auto& pair : instanceMap) {
-    for (auto& slot : pair.second) {
-      slot->clearBaselineInstances();
+  for (Slot& slot : slots) {
+    for (int instID : slot.getBaselineInstances()) {
+      glbBaselinePlacement.clearSlotRef(instID);
     }
+    slot.clearBaselineInstances();
   }
 }
 
 void Tile::clearOptimizedInstances() {
-  for (auto& pair : instanceMap) {
-    for (auto& slot : pair.second) {
-      slot->clearOptimizedInstances();
+  for (Slot& slot : slots) {
+    for (int instID : slot.getOptimizedInstances()) {
+      glbOptimizedPlacement.clearSlotRef(instID);
     }
+    slot.clearOptimizedInstances();
   }
 }
 
-slotArr* Tile::getInstanceByType (std::string type) {
-  auto mapIter = instanceMap.find(type);
-  if (mapIter == instanceMap.end()) {
-    return nullptr;
+void Tile::renumberInstances(const std::vector<int>& newIDs) {
+  for (Slot& slot : slots) {
+    slot.renumberInstances(newIDs);
+  }
+}
+
+// net IDs as named in the files, so reports list them in name order
+static std::set<int> toExternalNetIDs(const std::set<int>& netIDs) {
+  std::set<int> externalIDs;
+  for (int netID : netIDs) {
+    externalIDs.insert(glbNetIDs.toExternal(netID));
   }
-  return &(mapIter->second);
+  return externalIDs;
 }
 
 void Tile::reportTile() {
   // report tile occupation
   std::string typeStr;
-  for (auto type : tileTypes) {
-    typeStr += type + " ";
+  for (int type = 0; type < NUM_TILE_TYPES; type++) {
+    if (hasType((TileType)type)) {
+      typeStr += std::string(tileTypeNames[type]) + " ";
+    }
   }
   std::cout << "  Tile " << getLocStr() << " type: " << typeStr << std::endl;
   
@@ -108,36 +193,44 @@ void Tile::reportTile() {
   std::cout << std::setw(15) << "| Total" << std::endl;
   std::cout << "  " << std::string(55, '-') << std::endl;
 
-  for (auto& pair : instanceMap) {
+  for (int kind = 0; kind < NUM_SLOT_KINDS; kind++) {
+    const Slot* kindSlots = getSlots((SlotKind)kind);
+    if (kindSlots == nullptr) {
+      continue;
+    }
     std::pair<int, int> occupiedSlotCnt = std::make_pair(0, 0);
-    for (unsigned int i = 0; i < pair.second.size(); i++) {
-      if (pair.second[i]->getBaselineInstances().size() > 0) {
+    for (int i = 0; i < slotCapacity[kind]; i++) {
+      if (kindSlots[i].getBaselineInstances().size() > 0) {
         occupiedSlotCnt.first++;
       }
-      if (pair.second[i]->getOptimizedInstances().size() > 0) {
+      if (kindSlots[i].getOptimizedInstances().size() > 0) {
         occupiedSlotCnt.second++;
       }
     }  
-    std::cout <<"  " << std::left << std::setw(15) << pair.first;
+    std::cout <<"  " << std::left << std::setw(15) << slotKindNames[kind];
     std::string printStr = "( " + std::to_string(occupiedSlotCnt.first) + ", " + std::to_string(occupiedSlotCnt.second) + " )";
     std::cout <<"| " << std::setw(30) << printStr;
-    std::cout <<"| " << std::setw(13) << pair.second.size() << std::endl;        
+    std::cout <<"| " << std::setw(13) << slotCapacity[kind] << std::endl;        
   }
   
   std::cout << "  " << std::string(55, '-') << std::endl;
   std::cout << std::endl;
 
   // more detailed information w.r.t occupation
-  for (auto& pair : instanceMap) {    
-    for (unsigned int i = 0; i < pair.second.size(); i++) {
-      if (pair.second[i]->getBaselineInstances().size() == 0 && 
-          pair.second[i]->getOptimizedInstances().size() == 0) {
+  for (int kind = 0; kind < NUM_SLOT_KINDS; kind++) {    
+    const Slot* kindSlots = getSlots((SlotKind)kind);
+    if (kindSlots == nullptr) {
+      continue;
+    }
+    for (int i = 0; i < slotCapacity[kind]; i++) {
+      if (kindSlots[i].getBaselineInstances().size() == 0 && 
+          kindSlots[i].getOptimizedInstances().size() == 0) {
         continue;
       }
-      std::cout << "  " << pair.first << " #" << i << " (baseline, optimized)"<< std::endl;      
+      std::cout << "  " << slotKindNames[kind] << " #" << i << " (baseline, optimized)"<< std::endl;      
 
-      std::list<int> baselineInstArr = pair.second[i]->getBaselineInstances();
-      std::list<int> optimizedInstArr = pair.second[i]->getOptimizedInstances();
+      const SlotInstances& baselineInstArr = kindSlots[i].getBaselineInstances();
+      const SlotInstances& optimizedInstArr = kindSlots[i].getOptimizedInstances();
 
       // print two columns
       // left one is baseline instances
@@ -151,9 +244,9 @@ void Tile::reportTile() {
         // Print baseline instance
         if (baselineIt != baselineInstArr.end()) {
           int instID = *baselineIt;
-          if (glbInstMap.find(instID) != glbInstMap.end()) {
-            Instance* instPtr = glbInstMap[instID];
-            std::cout << std::left << std::setw(20) << ("inst_" + std::to_string(instID) + " " + instPtr->getModelName());
+          Instance* instPtr = glbInstMap.get(instID);
+          if (instPtr != nullptr) {
+            std::cout << std::left << std::setw(20) << (instPtr->getInstanceName() + " " + instPtr->getModelName());
           } else {
             std::cout << std::left << std::setw(20) << "Error: Instance not found";
           }
@@ -167,9 +260,9 @@ void Tile::reportTile() {
         // Print optimized instance
         if (optimizedIt != optimizedInstArr.end()) {
           int instID = *optimizedIt;
-          if (glbInstMap.find(instID) != glbInstMap.end()) {
-            Instance* instPtr = glbInstMap[instID];
-            std::cout << std::left << std::setw(30) << ("inst_" + std::to_string(instID) + " " + instPtr->getModelName());
+          Instance* instPtr = glbInstMap.get(instID);
+          if (instPtr != nullptr) {
+            std::cout << std::left << std::setw(30) << (instPtr->getInstanceName() + " " + instPtr->getModelName());
           } else {
             std::cout << std::left << std::setw(30) << "Error: Instance not found";
           }
@@ -185,8 +278,8 @@ void Tile::reportTile() {
   std::cout << std::endl;
 
   // report pin utilization
-  std::set<int> baselineInpinSet = getConnectedLutSeqInput(true);
-  std::set<int> optimizedInpinSet = getConnectedLutSeqInput(false);  
+  std::set<int> baselineInpinSet = toExternalNetIDs(getConnectedLutSeqInput(true));
+  std::set<int> optimizedInpinSet = toExternalNetIDs(getConnectedLutSeqInput(false));  
 
   std::cout << "  Detailed pin utilization:" << std::endl;
   std::cout << "    Input nets: Baseline " << baselineInpinSet.size() << "/" << MAX_TILE_PIN_INPUT_COUNT;
@@ -215,8 +308,8 @@ void Tile::reportTile() {
 
   // print output pin utilization
   std::cout << std::endl;
-  std::set<int> baselineOutpinSet = getConnectedLutSeqOutput(true);
-  std::set<int> optimizedOutpinSet = getConnectedLutSeqOutput(false);
+  std::set<int> baselineOutpinSet = toExternalNetIDs(getConnectedLutSeqOutput(true));
+  std::set<int> optimizedOutpinSet = toExternalNetIDs(getConnectedLutSeqOutput(false));
 
   std::cout << "  Detailed output pin utilization:" << std::endl;
   std::cout << "    Output nets: Baseline " << baselineOutpinSet.size() << "/" << MAX_TILE_PIN_OUTPUT_COUNT;
@@ -257,6 +350,13 @@ void Tile::reportTile() {
     std::set<int> optimizedSrNets;
     getControlSet(false, bank, optimizedClkNets, optimizedCeNets, optimizedSrNets);   
 
+    baselineClkNets = toExternalNetIDs(baselineClkNets);
+    baselineCeNets = toExternalNetIDs(baselineCeNets);
+    baselineSrNets = toExternalNetIDs(baselineSrNets);
+    optimizedClkNets = toExternalNetIDs(optimizedClkNets);
+    optimizedCeNets = toExternalNetIDs(optimizedCeNets);
+    optimizedSrNets = toExternalNetIDs(optimizedSrNets);
+
     std::cout << "    Bank " << bank << std::endl;    
     if (baselineClkNets.size() > 0 || optimizedClkNets.size() > 0) {
       std::cout << "      Clock nets: baseline = " << baselineClkNets.size() << ", optimized = " << optimizedClkNets.size() << std::endl;
@@ -331,110 +431,66 @@ void Tile::reportTile() {
   }
 }
 
+void Tile::addSlots(SlotKind kind, bool isLazy) {
+  if (isLazy) {
+    slotBegin[kind] = SLOT_LAZY;
+  } else {
+    allocSlots(kind);
+  }
+}
+
+Slot* Tile::allocSlots(SlotKind kind) {
+  slotBegin[kind] = slots.size();
+  slots.resize(slots.size() + slotCapacity[kind]);
+  return &slots[slotBegin[kind]];
+}
+
+// stands in for the slots of a lazy kind that were never allocated, as many
+// as the largest lazy kind has
+static const Slot unallocatedSlots[MAX_IPPIN_CAPACITY];
+
+const Slot* Tile::getSlots(SlotKind kind) const {
+  if (!hasSlots(kind)) {
+    return nullptr;
+  }
+  if (slotBegin[kind] == SLOT_LAZY) {
+    return unallocatedSlots;
+  }
+  return &slots[slotBegin[kind]];
+}
+
 bool Tile::initTile(const std::string& tileType) {
   
-  if (tileTypes.find(tileType) != tileTypes.end()) {
+  TileType type = getTileType(tileType);
+  if (type != NUM_TILE_TYPES && hasType(type)) {
     std::cout << "Error: Slot already initialized with same type " << tileType << std::endl;
     return false;
-  } else {
-    tileTypes.insert(tileType);
+  } else if (type != NUM_TILE_TYPES) {
+    addType(type);
   }
   
   if (tileType == "PLB") {
-    std::vector<Slot*> tmpLutSlotArr;
-    for (unsigned int i = 0; i < MAX_LUT_CAPACITY; i++) {
-      Slot* slot = new Slot();
-      tmpLutSlotArr.push_back(slot);   
-    }
-    instanceMap["LUT"] = tmpLutSlotArr;
-
-    std::vector<Slot*> tmpDffSlotArr;
-    for (unsigned int i = 0; i < MAX_DFF_CAPACITY; i++) {
-      Slot* slot = new Slot();
-      tmpDffSlotArr.push_back(slot);   
-    }
-    instanceMap["SEQ"] = tmpDffSlotArr;
-
-    std::vector<Slot*> tmpCarrySlotArr;
-    for (unsigned int i = 0; i < MAX_CARRY4_CAPACITY; i++) {
-      Slot* slot = new Slot();
-      tmpCarrySlotArr.push_back(slot);   
-    }
-    instanceMap["CARRY4"] = tmpCarrySlotArr;
-
-    std::vector<Slot*> tmpF7SlotArr;
-    for (unsigned int i = 0; i < MAX_F7_CAPACITY; i++) {
-      Slot* slot = new Slot();
-      tmpF7SlotArr.push_back(slot);   
-    }
-    instanceMap["F7MUX"] = tmpF7SlotArr;
-
-    std::vector<Slot*> tmpF8SlotArr;
-    for (unsigned int i = 0; i < MAX_F8_CAPACITY; i++) {
-      Slot* slot = new Slot();
-      tmpF8SlotArr.push_back(slot);   
-    }
-    instanceMap["F8MUX"] = tmpF8SlotArr;
-
-    std::vector<Slot*> tmpDramSlotArr;
-    for (unsigned int i = 0; i < MAX_DRAM_CAPACITY; i++) {
-      Slot* slota = new Slot();
-      tmpDramSlotArr.push_back(slota);   
-    }
-    instanceMap["DRAM"] = tmpDramSlotArr;
-
+    addSlots(SLOT_LUT);
+    addSlots(SLOT_SEQ);
+    addSlots(SLOT_CARRY4);
+    addSlots(SLOT_F7MUX);
+    addSlots(SLOT_F8MUX);
+    addSlots(SLOT_DRAM);
   } else if (tileType == "DSP") {
-    std::vector<Slot*> tmpSlotArr;
-    for (unsigned int i = 0; i < MAX_DSP_CAPACITY; i++) {
-      Slot* slot = new Slot();
-      tmpSlotArr.push_back(slot);   
-    }
-    instanceMap["DSP"] = tmpSlotArr;
+    addSlots(SLOT_DSP);
   } else if (tileType == "RAMA") {
-    std::vector<Slot*> tmpSlotArr;
-    for (unsigned int i = 0; i < MAX_RAM_CAPACITY; i++) {
-      Slot* slot = new Slot();
-      tmpSlotArr.push_back(slot);   
-    }
-    instanceMap["RAMA"] = tmpSlotArr;
+    addSlots(SLOT_RAMA);
   } else if (tileType == "RAMB") {
-    std::vector<Slot*> tmpSlotArr;
-    for (unsigned int i = 0; i < MAX_RAM_CAPACITY; i++) {
-      Slot* slot = new Slot();
-      tmpSlotArr.push_back(slot);   
-    }
-    instanceMap["RAMB"] = tmpSlotArr;
+    addSlots(SLOT_RAMB);
   } else if (tileType == "IOA") {
-    std::vector<Slot*> tmpSlotArr;
-    for (unsigned int i = 0; i < MAX_IO_CAPACITY; i++) {
-      Slot* slot = new Slot();
-      tmpSlotArr.push_back(slot);   
-    }
-    instanceMap["IOA"] = tmpSlotArr;
-
+    addSlots(SLOT_IOA);
   } else if (tileType == "IOB") {
-    std::vector<Slot*> tmpSlotArr;
-    for (unsigned int i = 0; i < MAX_IO_CAPACITY; i++) {
-      Slot* slot = new Slot();
-      tmpSlotArr.push_back(slot);   
-    }
-    instanceMap["IOB"] = tmpSlotArr;
-
+    addSlots(SLOT_IOB);
   } else if (tileType == "GCLK") {
-    std::vector<Slot*> tmpSlotArr;
-    for (unsigned int i = 0; i < MAX_GCLK_CAPACITY; i++) {
-      Slot* slot = new Slot();
-      tmpSlotArr.push_back(slot);   
-    }
-    instanceMap["GCLK"] = tmpSlotArr;
-
+    // GCLK and IPPIN tiles have many slots and few instances
+    addSlots(SLOT_GCLK, true);
   } else if (tileType == "IPPIN") {
-    std::vector<Slot*> tmpSlotArr;
-    for (unsigned int i = 0; i < MAX_IPPIN_CAPACITY; i++) {
-      Slot* slot = new Slot();
-      tmpSlotArr.push_back(slot);   
-    }
-    instanceMap["IPPIN"] = tmpSlotArr;
+    addSlots(SLOT_IPPIN, true);
   } else if (tileType == "FIXED") {
   } else {
     std::cout << "Error: Invalid slot type " << tileType << std::endl;
@@ -444,18 +500,19 @@ bool Tile::initTile(const std::string& tileType) {
 }
 
 bool Tile::isEmpty(bool isBaseline) {
-  for (auto& pair : instanceMap) {
-    for (auto& slot : pair.second) {
-      // skip ippin
-      if(pair.first == "IPPIN"){
-        continue;
-      }
+  for (int kind = 0; kind < NUM_SLOT_KINDS; kind++) {
+    const Slot* kindSlots = getSlots((SlotKind)kind);
+    // skip ippin
+    if (kindSlots == nullptr || kind == SLOT_IPPIN) {
+      continue;
+    }
+    for (int idx = 0; idx < slotCapacity[kind]; idx++) {
       if (isBaseline) {
-        if (!slot->getBaselineInstances().empty()) {
+        if (!kindSlots[idx].getBaselineInstances().empty()) {
           return false;
         }
       } else {
-        if (!slot->getOptimizedInstances().empty()) {
+        if (!kindSlots[idx].getOptimizedInstances().empty()) {
           return false;
         }
       }
@@ -464,62 +521,53 @@ bool Tile::isEmpty(bool isBaseline) {
   return true;
 }
 
-std::set<int> Tile::getConnectedLutSeqInput(bool isBaseline) {    
+template <typename View>
+std::set<int> Tile::getConnectedLutSeqInput(const View& view) {    
   std::set<int> netSet;  // using set to merge identical nets
-  if (matchType("PLB") == false) {
+  if (!hasType(TILE_PLB)) {
     return netSet;
   }
+  const PlacementStore& placement = view.placement();
 
-  for (auto mapIter : instanceMap) {
-    std::string slotType = mapIter.first;
-
-    if (slotType != "LUT" && slotType != "SEQ") {
+  static const SlotKind lutSeqKinds[] = {SLOT_LUT, SLOT_SEQ};
+  for (SlotKind kind : lutSeqKinds) {
+    const Slot* kindSlots = getSlots(kind);
+    if (kindSlots == nullptr) {
       continue;
     }
 
-    for (auto slot : mapIter.second) {
-      std::list<int> instArr;
-      if (isBaseline) {
-        instArr = slot->getBaselineInstances();
-      } else {
-        instArr = slot->getOptimizedInstances();
-      }
+    for (int idx = 0; idx < slotCapacity[kind]; idx++) {
+      const SlotInstances& instArr = view.instances(kindSlots[idx]);
       for (auto instID : instArr) {
-        if (glbInstMap.find(instID) == glbInstMap.end()) {
+        Instance* instPtr = glbInstMap.get(instID);
+        if (instPtr == nullptr) {
           std::cout << "Error: Instance ID " << instID << " not found in the global instance map" << std::endl;
           continue;
-        }      
-        Instance* instPtr = glbInstMap[instID];     
+        }
 
         int numInpins = instPtr->getNumInpins();
         for (int i = 0; i < numInpins; i++) {
-          Pin* pin = instPtr->getInpin(i);
-          // if (pin->getProp() != PIN_PROP_NONE) { 
+          Pin pin = instPtr->getInpin(i);
+          // if (pin.getProp() != PIN_PROP_NONE) { 
           //   // skip DFF ctrl, clk, reset pins
           //   continue;
           // }
-          int netID = pin->getNetID();                    
+          int netID = pin.getNetID();                    
           if (netID < 0) {  // unconnected pin
             continue;
           }
                     
-          if (glbNetMap.find(netID) == glbNetMap.end()) {
+          Net* netPtr = glbNetMap.get(netID);
+          if (netPtr == nullptr) {
             std::cout << "Error: Net ID " << netID << " not found in the global net map" << std::endl;
             continue;
           }
-          Net* netPtr = glbNetMap[netID];
 
           // check if driver is in the same tile
           // only count pins driven by nets from other tile
-          if (netPtr->getInpin() != nullptr) {
-            Instance* driverInstPtr = netPtr->getInpin()->getInstanceOwner();
-            std::tuple<int, int, int> driverLoc;
-            if (isBaseline) {
-              driverLoc = driverInstPtr->getBaseLocation();
-            } else {
-              driverLoc = driverInstPtr->getLocation();
-            }
-            if (std::get<0>(driverLoc) == col && std::get<1>(driverLoc) == row) {
+          if (netPtr->getInpin().isValid()) {
+            int driverID = netPtr->getInpin().getOwnerID();
+            if (placement.getX(driverID) == col && placement.getY(driverID) == row) {
               continue;
             }
           }
@@ -531,46 +579,47 @@ std::set<int> Tile::getConnectedLutSeqInput(bool isBaseline) {
   return netSet;
 }
 
-std::set<int> Tile::getConnectedLutSeqOutput(bool isBaseline) {
+std::set<int> Tile::getConnectedLutSeqInput(bool isBaseline) {
+  return isBaseline ? getConnectedLutSeqInput(BaselineView()) : getConnectedLutSeqInput(OptimizedView());
+}
+
+template <typename View>
+std::set<int> Tile::getConnectedLutSeqOutput(const View& view) {
   std::set<int> netSet;
-  if (matchType("PLB") == false) {
+  if (!hasType(TILE_PLB)) {
     return netSet;
   }
 
-  for (auto mapIter : instanceMap) {
-    std::string slotType = mapIter.first;
-    if (slotType != "LUT" && slotType != "SEQ") {
+  static const SlotKind lutSeqKinds[] = {SLOT_LUT, SLOT_SEQ};
+  for (SlotKind kind : lutSeqKinds) {
+    const Slot* kindSlots = getSlots(kind);
+    if (kindSlots == nullptr) {
       continue;
     }
 
-    for (auto slot : mapIter.second) {
-      std::list<int> instArr;
-      if (isBaseline) {
-        instArr = slot->getBaselineInstances();
-      } else {
-        instArr = slot->getOptimizedInstances();
-      }
+    for (int idx = 0; idx < slotCapacity[kind]; idx++) {
+      const SlotInstances& instArr = view.instances(kindSlots[idx]);
       for (auto instID : instArr) {
-        if (glbInstMap.find(instID) == glbInstMap.end()) {
+        Instance* instPtr = glbInstMap.get(instID);
+        if (instPtr == nullptr) {
           std::cout << "Error: Instance ID " << instID << " not found in the global instance map" << std::endl;
           continue;
-        }      
-        Instance* instPtr = glbInstMap[instID];     
+        }
 
         int numOutpins = instPtr->getNumOutpins();
         for (int i = 0; i < numOutpins; i++) {
-          Pin* pin = instPtr->getOutpin(i);
-          int netID = pin->getNetID();
+          Pin pin = instPtr->getOutpin(i);
+          int netID = pin.getNetID();
           if (netID < 0) {  // unconnected pin
             continue;
           }
           
-          if (glbNetMap.find(netID) == glbNetMap.end()) {
+          Net* netPtr = glbNetMap.get(netID);
+          if (netPtr == nullptr) {
             std::cout << "Error: Net ID " << netID << " not found in the global net map" << std::endl;
             continue;
           }
-          Net* netPtr = glbNetMap[netID];
-          if (netPtr->isIntraTileNet(isBaseline)) {
+          if (netPtr->isIntraTileNet(view)) {
             continue;
           }
           netSet.insert(netID);    
@@ -581,112 +630,231 @@ std::set<int> Tile::getConnectedLutSeqOutput(bool isBaseline) {
   return netSet;
 }
 
+std::set<int> Tile::getConnectedLutSeqOutput(bool isBaseline) {
+  return isBaseline ? getConnectedLutSeqOutput(BaselineView()) : getConnectedLutSeqOutput(OptimizedView());
+}
+
+// add the connected nets of the pins of an instance with the given property
+static void collectPropNets(const Instance* instPtr, PinProp prop, std::set<int>& nets) {
+  const Lib* lib = instPtr->getCellLib();
+  if (lib == nullptr) {
+    return;
+  }
+  for (int idx : lib->getInputsWithProp(prop)) {
+    int netID = instPtr->getInpin(idx).getNetID();
+    if (netID >= 0) {
+      nets.insert(netID);
+    }
+  }
+  for (int idx : lib->getOutputsWithProp(prop)) {
+    int netID = instPtr->getOutpin(idx).getNetID();
+    if (netID >= 0) {
+      nets.insert(netID);
+    }
+  }
+}
+
+template <typename View>
 bool Tile::getControlSet(
-  const bool isBaseline,
+  const View& view,
   const int bank,
   std::set<int> &clkNets,
   std::set<int> &ceNets,
   std::set<int> &srNets) {
 
-  for (auto mapIter : instanceMap) {
-    std::string slotType = mapIter.first;
-    // in PLB, only SEQ has control pins
-    if (slotType != "SEQ") {
-      continue;
-    }
+  // in PLB, only SEQ has control pins
+  const Slot* seqSlots = getSlots(SLOT_SEQ);
+  if (seqSlots == nullptr) {
+    return true;
+  }
     
-    // DFF bank0: 0-7, bank1: 8-15
-    int startIdx = 0;
-    int endIdx = 15;
-    if (bank == 0) {
-      startIdx = 0;
-      endIdx = 7;
-    } else if (bank == 1) {
-      startIdx = 8;
-      endIdx = 15;
-    } else {
-      std::cout << "Error: Invalid bank ID " << bank << std::endl;
-      return false;
-    }
+  // DFF bank0: 0-7, bank1: 8-15
+  int startIdx = 0;
+  int endIdx = 15;
+  if (bank == 0) {
+    startIdx = 0;
+    endIdx = 7;
+  } else if (bank == 1) {
+    startIdx = 8;
+    endIdx = 15;
+  } else {
+    std::cout << "Error: Invalid bank ID " << bank << std::endl;
+    return false;
+  }
 
-    for (int slotIdx = startIdx; slotIdx <= endIdx; slotIdx++) {        
-      Slot* slotPtr = mapIter.second[slotIdx];
-      std::list<int> instArr;
-      if (isBaseline) {
-        instArr = slotPtr->getBaselineInstances();
-      } else {
-        instArr = slotPtr->getOptimizedInstances();
+  for (int slotIdx = startIdx; slotIdx <= endIdx; slotIdx++) {        
+    const SlotInstances& instArr = view.instances(seqSlots[slotIdx]);
+    for (auto instID : instArr) {
+      Instance* instPtr = glbInstMap.get(instID);
+      if (instPtr == nullptr) {
+        std::cout << "Error: Instance ID " << instID << " not found in the global instance map" << std::endl;
+        return false;
       }
-      for (auto instID : instArr) {
-        if (glbInstMap.find(instID) == glbInstMap.end()) {
-          std::cout << "Error: Instance ID " << instID << " not found in the global instance map" << std::endl;
-          return false;
-        }      
-        Instance* instPtr = glbInstMap[instID];     
 
-        int numInpins = instPtr->getNumInpins();
-        for (int i = 0; i < numInpins; i++) {
-          Pin* pin = instPtr->getInpin(i);
-          int netID = pin->getNetID();
-          if (netID >= 0 ) {
-            PinProp prop = pin->getProp();
-            if (prop == PIN_PROP_CE) {
-              ceNets.insert(netID);
-            } else if (prop == PIN_PROP_CLOCK) {
-              clkNets.insert(netID);
-            } else if (prop == PIN_PROP_RESET) {
-              srNets.insert(netID);
-            }
-          }
-        }   
-        int numOutpins = instPtr->getNumOutpins();
-        for (int i = 0; i < numOutpins; i++) {
-          Pin* pin = instPtr->getOutpin(i);
-          int netID = pin->getNetID();
-          if (netID >= 0 ) {
-            PinProp prop = pin->getProp();
-            if (prop == PIN_PROP_CE) {
-              ceNets.insert(netID);
-            } else if (prop == PIN_PROP_CLOCK) {
-              clkNets.insert(netID);
-            } else if (prop == PIN_PROP_RESET) {
-              srNets.insert(netID);
-            }
-          }
-        }    
-      }
-    }    
+      // only the control pins listed in the lib are visited
+      collectPropNets(instPtr, PIN_PROP_CE, ceNets);
+      collectPropNets(instPtr, PIN_PROP_CLOCK, clkNets);
+      collectPropNets(instPtr, PIN_PROP_RESET, srNets);
+    }
   }    
   return true;
 }
 
+bool Tile::getControlSet(
+  const bool isBaseline,
+  const int bank,
+  std::set<int> &clkNets,
+  std::set<int> &ceNets,
+  std::set<int> &srNets) {
+  if (isBaseline) {
+    return getControlSet(BaselineView(), bank, clkNets, ceNets, srNets);
+  }
+  return getControlSet(OptimizedView(), bank, clkNets, ceNets, srNets);
+}
+
 void ClockRegion::reportClockRegion() {
   std::cout << "  Clock region " << getLocStr() << " has " << clockNets.size() << " clock nets." << std::endl;
-  for (auto netID : clockNets) {
+  for (auto netID : toExternalNetIDs(clockNets)) {
     std::cout << "    net_" << netID << std::endl;
   }
 }
 
-Instance::~Instance() {
-  for (auto& pin : inpins) {
-    delete pin;
+Lib::Lib(std::string libname) : name(libname) {
+  // resolved once here, instances are placed by these
+  slotType = unifyModelType(name);
+  slotKind = ::getSlotKind(slotType);
+  tileMask = getModelTileMask(name);
+}
+
+void Lib::buildPinTables() {
+  for (int prop = 0; prop < NUM_PIN_PROPS; prop++) {
+    inputsByProp[prop].clear();
+    outputsByProp[prop].clear();
   }
-  inpins.clear();
-  for (auto& pin : outpins) {
-    delete pin;
+  for (unsigned int i = 0; i < inputs.size(); i++) {
+    inputsByProp[inputs[i].second].push_back(i);
+  }
+  for (unsigned int i = 0; i < outputs.size(); i++) {
+    outputsByProp[outputs[i].second].push_back(i);
   }
-  outpins.clear();
 }
 
-Instance::Instance() {
+int PinStore::addPins(int ownerID, const Lib* lib) {
+  int first = netIDs.size();
+  const auto& libInputs = lib->getInputs();
+  const auto& libOutputs = lib->getOutputs();
+  size_t numPins = first + libInputs.size() + libOutputs.size();
+  netIDs.resize(numPins, -1);
+  critical.resize(numPins, 0);
+  owners.resize(numPins, ownerID);
+  for (const auto& libPin : libInputs) {
+    props.push_back(libPin.second);
+  }
+  for (const auto& libPin : libOutputs) {
+    props.push_back(libPin.second);
+  }
+  return first;
+}
+
+int PinStore::copyPins(const PinStore& src, int first, int numPins) {
+  int newFirst = netIDs.size();
+  netIDs.insert(netIDs.end(), src.netIDs.begin() + first, src.netIDs.begin() + first + numPins);
+  props.insert(props.end(), src.props.begin() + first, src.props.begin() + first + numPins);
+  critical.insert(critical.end(), src.critical.begin() + first, src.critical.begin() + first + numPins);
+  owners.insert(owners.end(), src.owners.begin() + first, src.owners.begin() + first + numPins);
+  return newFirst;
+}
+
+void PinStore::renumber(const std::vector<int>& newInstIDs, const std::vector<int>& newNetIDs) {
+  for (size_t pin = 0; pin < netIDs.size(); pin++) {
+    owners[pin] = newInstIDs[owners[pin]];
+    if (netIDs[pin] >= 0) {
+      netIDs[pin] = newNetIDs[netIDs[pin]];
+    }
+  }
+}
+
+void PinStore::clear() {
+  netIDs.clear();
+  props.clear();
+  critical.clear();
+  owners.clear();
+}
+
+int NetSinkStore::addRow(const Pin* begin, const Pin* end) {
+  sinkPins.insert(sinkPins.end(), begin, end);
+  offsets.push_back(sinkPins.size());
+  return offsets.size() - 2;
+}
+
+void NetSinkStore::reserve(size_t numRows, size_t numSinks) {
+  offsets.reserve(offsets.size() + numRows);
+  sinkPins.reserve(sinkPins.size() + numSinks);
+}
+
+void NetSinkStore::clear() {
+  offsets.assign(1, 0);
+  sinkPins.clear();
+}
+
+Instance* Pin::getInstanceOwner() const {
+  return glbInstMap.get(getOwnerID());
+}
+
+void PlacementStore::addInstance(int instID) {
+  if ((size_t)instID >= xs.size()) {
+    SlotRef noSlot = {-1, 0, 0};
+    xs.resize(instID + 1, -1);
+    ys.resize(instID + 1, -1);
+    zs.resize(instID + 1, -1);
+    slotRefs.resize(instID + 1, noSlot);
+  }
+  setLocation(instID, std::make_tuple(-1, -1, -1));
+  clearSlotRef(instID);
+}
+
+void PlacementStore::renumber(const std::vector<int>& newIDs, int numIDs) {
+  std::vector<int> newXs(numIDs, -1);
+  std::vector<int> newYs(numIDs, -1);
+  std::vector<int> newZs(numIDs, -1);
+  std::vector<SlotRef> newSlotRefs(numIDs);
+  for (size_t id = 0; id < xs.size(); id++) {
+    int newID = id < newIDs.size() ? newIDs[id] : -1;
+    if (newID < 0) {
+      continue;
+    }
+    newXs[newID] = xs[id];
+    newYs[newID] = ys[id];
+    newZs[newID] = zs[id];
+    newSlotRefs[newID] = slotRefs[id];
+  }
+  xs.swap(newXs);
+  ys.swap(newYs);
+  zs.swap(newZs);
+  slotRefs.swap(newSlotRefs);
+}
+
+void PlacementStore::clear() {
+  xs.clear();
+  ys.clear();
+  zs.clear();
+  slotRefs.clear();
+}
+
+Instance::Instance(int instID) {
+  id = instID;
   cellLib = nullptr;
   fixed = false;
-  setLocation(std::make_tuple(-1, -1, -1));
-  setBaseLocation(std::make_tuple(-1, -1, -1));
+  pinBegin = 0;
+  numInpins = 0;
+  numOutpins = 0;
+  glbOptimizedPlacement.addInstance(id);
+  glbBaselinePlacement.addInstance(id);
 }
 
 bool Instance::isPlaced() {
-  if (std::get<0>(location) == -1 || std::get<1>(location) == -1 || std::get<2>(location) == -1) {
+  const PlacementStore& placement = glbOptimizedPlacement;
+  if (placement.getX(id) == -1 || placement.getY(id) == -1 || placement.getZ(id) == -1) {
     return false;
   } else {
     return true;
@@ -694,9 +862,9 @@ bool Instance::isPlaced() {
 }
 
 bool Instance::isMoved() {
-  if (std::get<0>(location) != std::get<0>(baseLocation) ||
-      std::get<1>(location) != std::get<1>(baseLocation) ||
-      std::get<2>(location) != std::get<2>(baseLocation)) {
+  if (glbOptimizedPlacement.getX(id) != glbBaselinePlacement.getX(id) ||
+      glbOptimizedPlacement.getY(id) != glbBaselinePlacement.getY(id) ||
+      glbOptimizedPlacement.getZ(id) != glbBaselinePlacement.getZ(id)) {
     return true;
   } else {
     return false;
@@ -707,200 +875,99 @@ void Instance::setCellLib(Lib* libPtr) {
   cellLib = libPtr;
 
   // create pins   
-  createInpins();   
-  createOutpins();
-}
-
-void Instance::createInpins() {
-  if (cellLib == nullptr) {
-    return;
-  }
-  for (int i = 0; i < cellLib->getNumInputs(); i++) {
-    Pin* pin = new Pin();
-    pin->setNetID(-1);
-    pin->setInstanceOwner(this);
-    pin->setProp(cellLib->getInputProp(i));
-    inpins.push_back(pin);
-  }
+  createPins();
 }
 
-void Instance::createOutpins() {
+void Instance::createPins() {
   if (cellLib == nullptr) {
     return;
   }
-  for (int i = 0; i < cellLib->getNumOutputs(); i++) {
-    Pin* pin = new Pin();
-    pin->setNetID(-1);
-    pin->setInstanceOwner(this);
-    pin->setProp(cellLib->getOutputProp(i));
-    outpins.push_back(pin);
-  }
+  pinBegin = glbPinStore.addPins(id, cellLib);
+  numInpins = cellLib->getNumInputs();
+  numOutpins = cellLib->getNumOutputs();
 }
 
-bool Net::isIntraTileNet(bool isBaseline) {
-  if (inpin == nullptr) {
+template <typename View>
+bool Net::isIntraTileNet(const View& view) {
+  if (!inpin.isValid()) {
     return false;
   }
-  Instance* driverInstPtr = inpin->getInstanceOwner();
-  std::tuple<int, int, int> driverLoc;
-  if (isBaseline) {
-    driverLoc = driverInstPtr->getBaseLocation();
-  } else {
-    driverLoc = driverInstPtr->getLocation();
-  }
-
-  for (const auto* outpin : getOutputPins()) {
-    Instance* sinkInstPtr = outpin->getInstanceOwner();
-    std::tuple<int, int, int> sinkLoc;
-    if (isBaseline) {
-      sinkLoc = sinkInstPtr->getBaseLocation();
-    } else {
-      sinkLoc = sinkInstPtr->getLocation();
-    }
-    if (std::get<0>(driverLoc) != std::get<0>(sinkLoc) || 
-        std::get<1>(driverLoc) != std::get<1>(sinkLoc)) {
+  const PlacementStore& placement = view.placement();
+  int driverID = inpin.getOwnerID();
+  int driverX = placement.getX(driverID);
+  int driverY = placement.getY(driverID);
+
+  for (const Pin& outpin : getOutputPins()) {
+    int sinkID = outpin.getOwnerID();
+    if (driverX != placement.getX(sinkID) || driverY != placement.getY(sinkID)) {
       return false;
     }
   }
   return true;
 }
 
-int Net::getNumPins() {
-  if(inpin != nullptr) {
-    return outputPins.size() + 1;
-  } else {    
-    return outputPins.size();
-  }
+bool Net::isIntraTileNet(bool isBaseline) {
+  return isBaseline ? isIntraTileNet(BaselineView()) : isIntraTileNet(OptimizedView());
 }
 
-// read net connections from netlist
-bool Net::addConnection(std::string conn) {
-  // inst_2 I1  
-  std::istringstream iss(conn);
-  std::vector<std::string> tokens;
-  std::string token;
-  while (iss >> token) {
-    tokens.push_back(token);
-  }
-
-  if (tokens.size() != 2) {
-    std::cout << "Error: Invalid connection format " << conn << std::endl;
-    return false;
-  }
-
-  int errCnt = 0;
-  Instance* instPtr = nullptr;
-  Pin* pinPtr = nullptr;
-
-  std::string instName = tokens[0];
-  size_t underscorePos = instName.find('_');
-  if (underscorePos != std::string::npos) {
-    std::string subStr = instName.substr(underscorePos + 1);
-    // Convert the second substring to an integer
-    int instID = std::stoi(subStr);
-    if (glbInstMap.find(instID) != glbInstMap.end()) {
-      instPtr = glbInstMap[instID];
-    }
-  } 
-
-  if (instPtr == nullptr) {
-    std::cout << "Invalid instance name format: " << instName << std::endl;
-    errCnt++;
-  } else {
-    std::string pinName = tokens[1];
-    underscorePos = pinName.find('_');
-    if (underscorePos != std::string::npos) {
-      std::string dirStr = pinName.substr(0, underscorePos);
-      std::string pinIDStr = pinName.substr(underscorePos + 1);
-      int pinID = std::stoi(pinIDStr);
-      if (dirStr == "I") {
-        pinPtr = instPtr->getInpin(pinID);
-        pinPtr->setNetID(getId());
-        addOutputPin(pinPtr);
-      } else if (dirStr == "O") {
-        pinPtr = instPtr->getOutpin(pinID);
-        pinPtr->setNetID(getId());
-        if (getInpin() != nullptr) {
-          std::cout << "Error: Multiple drivers for net ID = " << getId() << std::endl;
-          errCnt++;
-        }
-        setInpin(pinPtr);
-      } else {
-        std::cout << "Invalid pin name format: " << pinName << std::endl;
-        errCnt++;
-      }
-    }    
-  }
-
-  if (errCnt > 0) {
-    return false;
-  } else {
-    return true;
+int Net::getNumPins() {
+  if(inpin.isValid()) {
+    return getOutputPins().size() + 1;
+  } else {    
+    return getOutputPins().size();
   }
 }
 
-int Net::getCritWireLength(bool isBaseline) {
+template <typename View>
+int Net::getCritWireLength(const View& view) {
   int wirelength = 0;
-  const Pin* driverPin = getInpin();
-  if (!driverPin) {
+  Pin driverPin = getInpin();
+  if (!driverPin.isValid()) {
     return 0;  // Return 0 if there's no driver pin
   }
 
-  std::tuple<int, int, int> driverLoc;
-  if (isBaseline) {
-    driverLoc = driverPin->getInstanceOwner()->getBaseLocation();
-  } else {
-    driverLoc = driverPin->getInstanceOwner()->getLocation();
-  }
+  const PlacementStore& placement = view.placement();
+  int driverX = placement.getX(driverPin.getOwnerID());
+  int driverY = placement.getY(driverPin.getOwnerID());
 
   std::set<std::pair<int, int>> mergedPinLocs;  // merge identical pin locations
-  for (const auto* outpin : getOutputPins()) {
-    if (!outpin->getTimingCritical()) {
+  for (const Pin& outpin : getOutputPins()) {
+    if (!outpin.getTimingCritical()) {
       continue;
     }
-    std::tuple<int, int, int> sinkLoc;
-    if (isBaseline) {
-      sinkLoc = outpin->getInstanceOwner()->getBaseLocation();
-    } else {
-      sinkLoc = outpin->getInstanceOwner()->getLocation();
-    }
-    mergedPinLocs.insert(std::make_pair(std::get<0>(sinkLoc), std::get<1>(sinkLoc)));
+    int sinkID = outpin.getOwnerID();
+    mergedPinLocs.insert(std::make_pair(placement.getX(sinkID), placement.getY(sinkID)));
   }
 
   for (auto loc : mergedPinLocs) {
-    wirelength += std::abs(std::get<0>(loc) - std::get<0>(driverLoc)) +
-                  std::abs(std::get<1>(loc) - std::get<1>(driverLoc));
+    wirelength += std::abs(loc.first - driverX) + std::abs(loc.second - driverY);
   }
 
   return wirelength;
 }
 
-void Net::getMergedNonCritPinLocs(bool isBaseline, std::vector<int>& xCoords, std::vector<int>& yCoords) {
-  const Pin* driverPin = getInpin();
-  if (!driverPin) {
+int Net::getCritWireLength(bool isBaseline) {
+  return isBaseline ? getCritWireLength(BaselineView()) : getCritWireLength(OptimizedView());
+}
+
+template <typename View>
+void Net::getMergedNonCritPinLocs(const View& view, std::vector<int>& xCoords, std::vector<int>& yCoords) {
+  Pin driverPin = getInpin();
+  if (!driverPin.isValid()) {
     return;
   }
   std::set<std::pair<int, int>> rsmtPinLocs;
   
-  std::tuple<int, int, int> driverLoc;
-  if (isBaseline) {
-    driverLoc = driverPin->getInstanceOwner()->getBaseLocation();
-  } else {
-    driverLoc = driverPin->getInstanceOwner()->getLocation();
-  }
-  rsmtPinLocs.insert(std::make_pair(std::get<0>(driverLoc), std::get<1>(driverLoc)));
+  const PlacementStore& placement = view.placement();
+  int driverID = driverPin.getOwnerID();
+  rsmtPinLocs.insert(std::make_pair(placement.getX(driverID), placement.getY(driverID)));
   
-  for (const auto* outpin : getOutputPins()) {
-    if (outpin->getTimingCritical()) {
+  for (const Pin& outpin : getOutputPins()) {
+    if (outpin.getTimingCritical()) {
       continue;
     }
-    std::tuple<int, int, int> sinkLoc;
-    if (isBaseline) {
-      sinkLoc = outpin->getInstanceOwner()->getBaseLocation();
-    } else {
-      sinkLoc = outpin->getInstanceOwner()->getLocation();
-    }
-    rsmtPinLocs.insert(std::make_pair(std::get<0>(sinkLoc), std::get<1>(sinkLoc)));
+    int sinkID = outpin.getOwnerID();
+    rsmtPinLocs.insert(std::make_pair(placement.getX(sinkID), placement.getY(sinkID)));
   }
   for(auto loc : rsmtPinLocs) {
     xCoords.push_back(loc.first);
@@ -908,9 +975,17 @@ void Net::getMergedNonCritPinLocs(bool isBaseline, std::vector<int>& xCoords, st
   }
 }
 
+void Net::getMergedNonCritPinLocs(bool isBaseline, std::vector<int>& xCoords, std::vector<int>& yCoords) {
+  if (isBaseline) {
+    getMergedNonCritPinLocs(BaselineView(), xCoords, yCoords);
+  } else {
+    getMergedNonCritPinLocs(OptimizedView(), xCoords, yCoords);
+  }
+}
+
 int Net::getNonCritWireLength(bool isBaseline) {
-  const Pin* driverPin = getInpin();
-  if (!driverPin) {
+  Pin driverPin = getInpin();
+  if (!driverPin.isValid()) {
     return 0;  // Return 0 if there's no driver pin
   }
 
@@ -942,12 +1017,12 @@ bool Net::reportNet() {
     }
   }
   
-  std::cout << "  net_" << id << " " << propStr << std::endl;
+  std::cout << "  " << getNetName() << " " << propStr << std::endl;
 
   int numNonCritFanoutPins = 0;
   int numCritFanoutPins = 0;
-  for (const auto* outpin : getOutputPins()) {
-    if (outpin->getTimingCritical()) {
+  for (const Pin& outpin : getOutputPins()) {
+    if (outpin.getTimingCritical()) {
       numCritFanoutPins++;
     } else{
       numNonCritFanoutPins++;
@@ -975,3 +1050,17 @@ bool Net::reportNet() {
 
   return true;
 }
+
+// placement views the kernels are compiled for
+template bool Tile::getControlSet(const BaselineView&, const int, std::set<int>&, std::set<int>&, std::set<int>&);
+template bool Tile::getControlSet(const OptimizedView&, const int, std::set<int>&, std::set<int>&, std::set<int>&);
+template std::set<int> Tile::getConnectedLutSeqInput(const BaselineView&);
+template std::set<int> Tile::getConnectedLutSeqInput(const OptimizedView&);
+template std::set<int> Tile::getConnectedLutSeqOutput(const BaselineView&);
+template std::set<int> Tile::getConnectedLutSeqOutput(const OptimizedView&);
+template bool Net::isIntraTileNet(const BaselineView&);
+template bool Net::isIntraTileNet(const OptimizedView&);
+template int Net::getCritWireLength(const BaselineView&);
+template int Net::getCritWireLength(const OptimizedView&);
+template void Net::getMergedNonCritPinLocs(const BaselineView&, std::vector<int>&, std::vector<int>&);
+template void Net::getMergedNonCritPinLocs(const OptimizedView&, std::vector<int>&, std::vector<int>&);
@@ -6,6 +6,8 @@
 #include <map>    // 包含对 std::map 的支持
 #include <vector> // 包含对 std::vector 的支持
 #include <set>    // 包含对 std::set 的支持
+#include <cstdint>
+#include "idtable.h"
 
 // PLB slots
 #define MAX_LUT_CAPACITY 8
@@ -21,6 +23,73 @@
 #define MAX_IPPIN_CAPACITY 256
 #define MAX_GCLK_CAPACITY 28
 
+// slot kinds of the tiles, kept in name order so per-kind walks list them alphabetically
+enum SlotKind {
+    SLOT_CARRY4,
+    SLOT_DRAM,
+    SLOT_DSP,
+    SLOT_F7MUX,
+    SLOT_F8MUX,
+    SLOT_GCLK,
+    SLOT_IOA,
+    SLOT_IOB,
+    SLOT_IPPIN,
+    SLOT_LUT,
+    SLOT_RAMA,
+    SLOT_RAMB,
+    SLOT_SEQ,
+    NUM_SLOT_KINDS   // also returned for unknown slot types
+};
+
+// number of slots of each kind in a tile providing that kind
+constexpr int slotCapacity[NUM_SLOT_KINDS] = {
+    MAX_CARRY4_CAPACITY,
+    MAX_DRAM_CAPACITY,
+    MAX_DSP_CAPACITY,
+    MAX_F7_CAPACITY,
+    MAX_F8_CAPACITY,
+    MAX_GCLK_CAPACITY,
+    MAX_IO_CAPACITY,
+    MAX_IO_CAPACITY,
+    MAX_IPPIN_CAPACITY,
+    MAX_LUT_CAPACITY,
+    MAX_RAM_CAPACITY,
+    MAX_RAM_CAPACITY,
+    MAX_DFF_CAPACITY
+};
+
+// slot type names for reports
+constexpr const char* slotKindNames[NUM_SLOT_KINDS] = {
+    "CARRY4", "DRAM", "DSP", "F7MUX", "F8MUX", "GCLK", "IOA", "IOB", "IPPIN", "LUT", "RAMA", "RAMB", "SEQ"
+};
+
+SlotKind getSlotKind(const std::string& slotType);  // slot type as given by unifyModelType
+
+// tile types, in name order like the slot kinds
+enum TileType {
+    TILE_DSP,
+    TILE_FIXED,
+    TILE_GCLK,
+    TILE_IOA,
+    TILE_IOB,
+    TILE_IPPIN,
+    TILE_PLB,
+    TILE_RAMA,
+    TILE_RAMB,
+    TILE_UNDEFINED,
+    NUM_TILE_TYPES   // also returned for unknown tile types
+};
+
+constexpr const char* tileTypeNames[NUM_TILE_TYPES] = {
+    "DSP", "FIXED", "GCLK", "IOA", "IOB", "IPPIN", "PLB", "RAMA", "RAMB", "UNDEFINED"
+};
+
+typedef uint16_t TileTypeMask;   // bit (1 << type) set for each tile type
+inline TileTypeMask tileTypeBit(TileType type) { return (TileTypeMask)(1u << type); }
+
+TileType getTileType(const std::string& tileType);
+TileTypeMask getModelTileMask(const std::string& modelType);   // tile types hosting the model, LUT/SEQ to PLB
+
 // 
 #define MAX_TILE_CE_PER_PLB_BANK 2
 #define MAX_TILE_RESET_PER_PLB_BANK 1
@@ -38,18 +107,42 @@ enum PinProp {
     PIN_PROP_CLOCK
 };
 
+#define NUM_PIN_PROPS (PIN_PROP_CLOCK + 1)
+
+#define SLOT_INLINE_INSTANCES 2   // a LUT slot holds up to 2 LUTs, other slots 1
+
+// instance IDs of a slot kept inline; only an over-full slot, which the
+// legality check reports, moves its IDs to the heap
+class SlotInstances {
+    int inlineIDs[SLOT_INLINE_INSTANCES];
+    int count;
+    std::vector<int> spilled;   // all IDs while count exceeds the inline capacity
+
+public:
+    SlotInstances() : count(0) {}
+
+    const int* begin() const { return count > SLOT_INLINE_INSTANCES ? spilled.data() : inlineIDs; }
+    const int* end() const { return begin() + count; }
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+    int operator[](int idx) const { return begin()[idx]; }
+
+    void push_back(int instID);
+    void remove(int instID);   // all occurrences, like std::list::remove
+    void clear() { count = 0; spilled.clear(); }
+    void renumber(const std::vector<int>& newIDs);   // old instance ID -> new one
+};
+
 class Slot {
     private:
         // normally each slot is holding 1 instance
         // the exception is the LUT slot can hold up to 2 LUTs
         // with shared inputs 
-        std::list<int> optimizedInstArr;  // container of the optimized design instances
-        std::list<int> baselineInstArr;   // container of the input design instances
+        SlotInstances optimizedInstArr;  // container of the optimized design instances
+        SlotInstances baselineInstArr;   // container of the input design instances
     public:
         // Constructor
         Slot() {}
-        // Destructor
-        ~Slot() {}
 
         // Getter and setter for type
         void clearInstances() {optimizedInstArr.clear(); baselineInstArr.clear();}
@@ -57,29 +150,47 @@ class Slot {
         void clearOptimizedInstances() {optimizedInstArr.clear();}
 
         void addOptimizedInstance(int instID) { optimizedInstArr.push_back(instID); }
-        std::list<int> getOptimizedInstances() const { return optimizedInstArr; }
+        void removeOptimizedInstance(int instID) { optimizedInstArr.remove(instID); }
+        const SlotInstances& getOptimizedInstances() const { return optimizedInstArr; }
 
         void addBaselineInstance(int instID) { baselineInstArr.push_back(instID); }
-        std::list<int> getBaselineInstances() const { return baselineInstArr; }
+        void removeBaselineInstance(int instID) { baselineInstArr.remove(instID); }
+        const SlotInstances& getBaselineInstances() const { return baselineInstArr; }
+
+        const SlotInstances& getInstances(bool isBaseline) const { return isBaseline ? baselineInstArr : optimizedInstArr; }
+
+        void renumberInstances(const std::vector<int>& newIDs) {
+            optimizedInstArr.renumber(newIDs);
+            baselineInstArr.renumber(newIDs);
+        }
 };
 
-typedef std::vector<Slot*> slotArr;
+class Lib;
+
+#define SLOT_NONE -1   // the tile does not provide the slot kind
+#define SLOT_LAZY -2   // provided, the slots are allocated on first use
 
 class Tile {
     private:
         int col;
         int row;
-        std::set<std::string> tileTypes;
+        TileTypeMask tileTypes;
 
-        // container to record instances belone to this tile
-        std::map<std::string, slotArr> instanceMap;
+        // slots of all kinds the tile provides, slotCapacity[kind] slots per kind;
+        // lazy kinds get theirs when the first instance lands in the tile
+        std::vector<Slot> slots;
+        int16_t slotBegin[NUM_SLOT_KINDS];   // first slot of each kind, SLOT_NONE or SLOT_LAZY
+
+        void addSlots(SlotKind kind, bool isLazy = false);
+        Slot* allocSlots(SlotKind kind);
 
     public:
         // Constructor
-        Tile(int c, int r) : col(c), row(r) {}
-
-        // Destructor
-        ~Tile();
+        Tile(int c, int r) : col(c), row(r), tileTypes(0) {
+            for (int kind = 0; kind < NUM_SLOT_KINDS; kind++) {
+                slotBegin[kind] = SLOT_NONE;
+            }
+        }
         
         // Getter and setter
         int getCol() const { return col; }
@@ -88,24 +199,38 @@ class Tile {
         void setRow(int value) { row = value; }
         
         // Getter and setter for tileTypes
-        std::set<std::string> getTileTypes() const { return tileTypes; }       
-        void addType(const std::string& tileType) { tileTypes.insert(tileType); }
-        unsigned int getNumTileTypes() const { return tileTypes.size(); }
+        TileTypeMask getTileTypes() const { return tileTypes; }       
+        void addType(TileType tileType) { tileTypes |= tileTypeBit(tileType); }
+        bool hasType(TileType tileType) const { return (tileTypes & tileTypeBit(tileType)) != 0; }
         
         std::string getLocStr() { return "X" + std::to_string(col) + "Y" + std::to_string(row); }
 
         bool initTile(const std::string& tileType);  // allocate slots
-        bool matchType(const std::string& modelType); // LUT/SEQ to PLB
+        bool matchType(TileTypeMask modelTiles) const { return (tileTypes & modelTiles) != 0; }
 
         bool isEmpty(bool isBaseline);        
-        bool addInstance(int instID, int offset, std::string modelType, const bool isBaseline);          
+        bool addInstance(int instID, int offset, const Lib* lib, const bool isBaseline);          
+        bool addInstance(int instID, int offset, const std::string& modelType, const bool isBaseline);   // by cell name
+        bool removeInstance(int instID, SlotKind kind, int offset, const bool isBaseline);
         void clearInstances();
         void clearBaselineInstances();
         void clearOptimizedInstances();
-        std::map<std::string, slotArr>::iterator getInstanceMapBegin() { return instanceMap.begin(); }
-        std::map<std::string, slotArr>::iterator getInstanceMapEnd() { return instanceMap.end(); }
-        slotArr* getInstanceByType (std::string type);
+        void renumberInstances(const std::vector<int>& newIDs);   // old instance ID -> new one
+
+        // slots of a kind, nullptr if the tile does not provide the kind;
+        // lazy slots not allocated yet are read as empty slots
+        bool hasSlots(SlotKind kind) const { return kind < NUM_SLOT_KINDS && slotBegin[kind] != SLOT_NONE; }
+        const Slot* getSlots(SlotKind kind) const;
         
+        // kernels templated on a placement view (BaselineView, OptimizedView),
+        // the bool overloads pick the view once
+        template <typename View>
+        bool getControlSet(
+            const View& view,
+            const int bank,
+            std::set<int> &clkNets,
+            std::set<int> &ceNets,
+            std::set<int> &srNets);
         bool getControlSet(
             const bool isBaseline,
             const int bank,
@@ -113,7 +238,11 @@ class Tile {
             std::set<int> &ceNets,
             std::set<int> &srNets);
         
+        template <typename View>
+        std::set<int> getConnectedLutSeqInput(const View& view);
         std::set<int> getConnectedLutSeqInput(bool isBaseline);
+        template <typename View>
+        std::set<int> getConnectedLutSeqOutput(const View& view);
         std::set<int> getConnectedLutSeqOutput(bool isBaseline);
 
         // report util
@@ -171,90 +300,228 @@ class ClockRegion {
 
 class Lib {
     std::string name;
+    std::string slotType;   // slot type instances of the cell occupy, e.g. LUT for LUT1..LUT6
+    SlotKind slotKind;      // slotType resolved, NUM_SLOT_KINDS if it is not a slot type
+    TileTypeMask tileMask;  // tile types instances of the cell can be placed on
     std::vector<std::pair<std::string, PinProp> > inputs;
     std::vector<std::pair<std::string, PinProp> > outputs;
 
+    // filled by buildPinTables once all pins are set
+    std::vector<int> inputsByProp[NUM_PIN_PROPS];    // input pin indices of each property
+    std::vector<int> outputsByProp[NUM_PIN_PROPS];   // output pin indices of each property
+
 public:
-    Lib(std::string libname) : name(libname)  {} // 默认构造函数
+    Lib(std::string libname); // 默认构造函数
     ~Lib() {} // 析构函数
 
     // Getter and setter for name
     std::string getName() const { return name; }
+    const std::string& getSlotType() const { return slotType; }
+    SlotKind getSlotKind() const { return slotKind; }
+    TileTypeMask getTileMask() const { return tileMask; }
    
     // Getter and setter for inputs
     int getNumInputs() const { return inputs.size(); }
     void setNumInputs(const int numIn) { inputs.resize(numIn); }
-    std::vector<std::pair<std::string, PinProp> > getInputs() const { return inputs;}
+    const std::vector<std::pair<std::string, PinProp> >& getInputs() const { return inputs;}
     void setInput(int idx, std::string input, PinProp prop) { inputs[idx].first = input; inputs[idx].second = prop; }
     
     // Getter and setter for outputs
     int getNumOutputs() const { return outputs.size(); }
     void setNumOutputs(const int numOut) { outputs.resize(numOut); }
-    std::vector<std::pair<std::string, PinProp> > getOutputs() const { return outputs; }
+    const std::vector<std::pair<std::string, PinProp> >& getOutputs() const { return outputs; }
     void setOutput(int idx, std::string output, PinProp prop) { outputs[idx].first = output; outputs[idx].second = prop; }
 
-    PinProp getInputProp(int idx) const { return inputs[idx].second; }
-    PinProp getOutputProp(int idx) const { return outputs[idx].second; }
+    // pin class tables
+    void buildPinTables();
+    const std::vector<int>& getInputsWithProp(PinProp prop) const { return inputsByProp[prop]; }
+    const std::vector<int>& getOutputsWithProp(PinProp prop) const { return outputsByProp[prop]; }
 };
 
 class Instance;
 
+// pins of all instances as parallel arrays indexed by pin index,
+// each instance owns a contiguous range: its inputs followed by its outputs
+class PinStore {
+    std::vector<int> netIDs;            // -1 means unconnected
+    std::vector<uint8_t> props;         // PinProp
+    std::vector<uint8_t> critical;      // timing critical flag
+    std::vector<int> owners;            // ID of the owner instance
+
+public:
+    // append the pins of an instance of the lib, return the index of the first one
+    int addPins(int ownerID, const Lib* lib);
+    // append a copy of numPins pins of src starting at first, return the index of the first copy
+    int copyPins(const PinStore& src, int first, int numPins);
+    void renumber(const std::vector<int>& newInstIDs, const std::vector<int>& newNetIDs);
+    void clear();
+    size_t size() const { return netIDs.size(); }
+
+    int getNetID(int pin) const { return netIDs[pin]; }
+    void setNetID(int pin, int value) { netIDs[pin] = value; }
+    PinProp getProp(int pin) const { return (PinProp)props[pin]; }
+    bool getTimingCritical(int pin) const { return critical[pin] != 0; }
+    void setTimingCritical(int pin, bool value) { critical[pin] = value; }
+    int getOwnerID(int pin) const { return owners[pin]; }
+};
+
+extern PinStore glbPinStore;
+
+// handle of a pin in glbPinStore
 class Pin {
-    int netID;
-    PinProp prop;
-    bool timingCritical;
-    Instance* instanceOwner;
+    int idx;   // -1 for no pin
 
 public: 
-    Pin() : netID(-1), prop(PIN_PROP_NONE), timingCritical(false), instanceOwner(nullptr) {} // 默认构造函数
-    ~Pin() {} // 析构函数
+    Pin() : idx(-1) {}
+    explicit Pin(int pinIdx) : idx(pinIdx) {}
+
+    int getIndex() const { return idx; }
+    bool isValid() const { return idx >= 0; }
+    bool operator==(const Pin& other) const { return idx == other.idx; }
+    bool operator!=(const Pin& other) const { return idx != other.idx; }
 
     // Getter and setter for netID
-    int getNetID() const { return netID; }  // -1 means unconnected
-    void setNetID(int value) { netID = value; }
+    int getNetID() const { return glbPinStore.getNetID(idx); }  // -1 means unconnected
+    void setNetID(int value) const { glbPinStore.setNetID(idx, value); }
 
-    // Getter and setter for prop
-    PinProp getProp() const { return prop; }
-    void setProp(PinProp value) { prop = value; }
+    PinProp getProp() const { return glbPinStore.getProp(idx); }
 
     // Getter and setter for isTimingCritical
-    bool getTimingCritical() const { return timingCritical; }
-    void setTimingCritical(bool value) { timingCritical = value; }
+    bool getTimingCritical() const { return glbPinStore.getTimingCritical(idx); }
+    void setTimingCritical(bool value) const { glbPinStore.setTimingCritical(idx, value); }
+
+    int getOwnerID() const { return glbPinStore.getOwnerID(idx); }
+    Instance* getInstanceOwner() const;
+};
+
+// sink pins of all nets in compressed sparse row form, the sinks of row r
+// are sinkPins[offsets[r]] .. sinkPins[offsets[r + 1] - 1]
+class NetSinkStore {
+    std::vector<int> offsets;   // one entry per row plus the end of the last row
+    std::vector<Pin> sinkPins;
+
+public:
+    NetSinkStore() : offsets(1, 0) {}
+
+    // append a row holding the given pins, return its index
+    int addRow(const Pin* begin, const Pin* end);
+    void reserve(size_t numRows, size_t numSinks);
+    void clear();
+
+    const Pin* rowBegin(int row) const { return sinkPins.data() + offsets[row]; }
+    const Pin* rowEnd(int row) const { return sinkPins.data() + offsets[row + 1]; }
+};
+
+extern NetSinkStore glbNetSinks;
+
+// read-only view of consecutive pins
+class PinRange {
+    const Pin* first;
+    const Pin* last;
+
+public:
+    PinRange() : first(nullptr), last(nullptr) {}
+    PinRange(const Pin* begin, const Pin* end) : first(begin), last(end) {}
 
-    // Getter and setter for instanceOwner
-    Instance* getInstanceOwner() const { return instanceOwner; }
-    void setInstanceOwner(Instance* inst) { instanceOwner = inst; }
+    const Pin* begin() const { return first; }
+    const Pin* end() const { return last; }
+    int size() const { return last - first; }
+    bool empty() const { return first == last; }
+};
+
+// slot holding an instance, tileIdx is -1 while the instance is in no slot
+struct SlotRef {
+    int tileIdx;       // index for Arch::getTileByIndex
+    int16_t kind;      // SlotKind
+    int16_t offset;    // slot among those of the kind
+};
+
+// coordinates of all instances in one placement as parallel arrays indexed
+// by instance ID, -1 for an unplaced instance; next to them the slot each
+// instance was added to, kept up to date by Tile
+class PlacementStore {
+    std::vector<int> xs;
+    std::vector<int> ys;
+    std::vector<int> zs;
+    std::vector<SlotRef> slotRefs;
+
+public:
+    void addInstance(int instID);   // the instance starts unplaced
+    void renumber(const std::vector<int>& newIDs, int numIDs);   // old instance ID -> new one
+    void clear();
+
+    int getX(int instID) const { return xs[instID]; }
+    int getY(int instID) const { return ys[instID]; }
+    int getZ(int instID) const { return zs[instID]; }
+    std::tuple<int, int, int> getLocation(int instID) const { return std::make_tuple(xs[instID], ys[instID], zs[instID]); }
+    void setLocation(int instID, const std::tuple<int, int, int>& loc) {
+        xs[instID] = std::get<0>(loc);
+        ys[instID] = std::get<1>(loc);
+        zs[instID] = std::get<2>(loc);
+    }
+
+    const SlotRef& getSlotRef(int instID) const { return slotRefs[instID]; }
+    void setSlotRef(int instID, int tileIdx, SlotKind kind, int offset) {
+        SlotRef& ref = slotRefs[instID];
+        ref.tileIdx = tileIdx;
+        ref.kind = kind;
+        ref.offset = offset;
+    }
+    void clearSlotRef(int instID) { slotRefs[instID].tileIdx = -1; }
+};
+
+extern PlacementStore glbBaselinePlacement;    // location before optimization
+extern PlacementStore glbOptimizedPlacement;   // location after optimization
+
+extern IdRenumbering glbInstIDs;   // instance IDs in the files, see renumberDesign
+extern IdRenumbering glbNetIDs;    // net IDs in the files
+
+inline const PlacementStore& getPlacement(bool isBaseline) {
+    return isBaseline ? glbBaselinePlacement : glbOptimizedPlacement;
+}
+
+// placement views the kernels are templated on, so their inner loops do not
+// test isBaseline; a view gives the coordinates and the slot contents of one
+// placement. Another view, e.g. a candidate placement, only needs these two
+// members and explicit instantiations next to the kernels
+struct BaselineView {
+    const PlacementStore& placement() const { return glbBaselinePlacement; }
+    const SlotInstances& instances(const Slot& slot) const { return slot.getBaselineInstances(); }
+};
+
+struct OptimizedView {
+    const PlacementStore& placement() const { return glbOptimizedPlacement; }
+    const SlotInstances& instances(const Slot& slot) const { return slot.getOptimizedInstances(); }
 };
 
 class Instance {
+    int id;
     bool fixed; // 声明 fixed 成员变量
     Lib* cellLib; // 声明 cellLib 成员变量
-    std::string instanceName; // 声明 instanceName 成员变量
-    std::string modelName; // 声明 modelName 成员变量
-    std::tuple<int, int, int> baseLocation; // location before optimization
-    std::tuple<int, int, int> location; // location after optimization
-    std::vector<Pin*> inpins;  
-    std::vector<Pin*> outpins;
+    int pinBegin;      // first pin in glbPinStore
+    int numInpins;
+    int numOutpins;
 
 public:
-    Instance(); 
-    ~Instance();
+    Instance(int instID); 
+    ~Instance() {}
+
+    int getId() const { return id; }
+    void setId(int value) { id = value; }   // only while renumbering
 
     // Getter and setter
-    std::tuple<int, int, int> getBaseLocation() const { return baseLocation; }
-    void setBaseLocation(const std::tuple<int, int, int>& loc) { baseLocation = loc; }
+    std::tuple<int, int, int> getBaseLocation() const { return glbBaselinePlacement.getLocation(id); }
+    void setBaseLocation(const std::tuple<int, int, int>& loc) { glbBaselinePlacement.setLocation(id, loc); }
 
-    std::tuple<int, int, int> getLocation() const { return location; }
-    void setLocation(const std::tuple<int, int, int>& loc) { location = loc; }
+    std::tuple<int, int, int> getLocation() const { return glbOptimizedPlacement.getLocation(id); }
+    void setLocation(const std::tuple<int, int, int>& loc) { glbOptimizedPlacement.setLocation(id, loc); }
 
     bool isFixed() const { return fixed; }
     void setFixed(bool value) { fixed = value;}
 
-    std::string getInstanceName() const { return instanceName; }
-    void setInstanceName(const std::string& name) { instanceName = name;}
-
-    std::string getModelName() const { return modelName; }
-    void setModelName(const std::string& name) { modelName = name; }
+    // names are not stored, they follow from the ID and the lib
+    std::string getInstanceName() const { return "inst_" + std::to_string(glbInstIDs.toExternal(id)); }
+    std::string getModelName() const { return cellLib->getName(); }
 
     Lib* getCellLib() const { return cellLib; }
     void setCellLib(Lib* lib);
@@ -262,53 +529,58 @@ public:
     bool isPlaced(); 
     bool isMoved();
 
-    void createInpins();
-    int getNumInpins() const { return inpins.size(); }
-    std::vector<Pin*> getInpins() const { return inpins; }
-    Pin* getInpin(int idx) const { return inpins[idx]; }
-    //void connectInpin(int netID, int idx) { inpins[idx].setNetID(netID); }
+    void createPins();
+    int getPinBegin() const { return pinBegin; }
+    void setPinBegin(int value) { pinBegin = value; }   // the pins were moved in glbPinStore
+    int getNumInpins() const { return numInpins; }
+    Pin getInpin(int idx) const { return Pin(pinBegin + idx); }
 
-    void createOutpins();
-    int getNumOutpins() const { return outpins.size(); }
-    std::vector<Pin*> getOutpins() const { return outpins; }
-    Pin* getOutpin(int idx) const { return outpins[idx]; }
-    //void connectOutpin(int netID, int idx) { outpins[idx].setNetID(netID); }
+    int getNumOutpins() const { return numOutpins; }
+    Pin getOutpin(int idx) const { return Pin(pinBegin + numInpins + idx); }
 
 };
 
 class Net {
     int id; // 声明 id 成员变量
     bool clock; // 声明 clock 成员变量    
-    Pin* inpin;
-    std::list<Pin*> outputPins;
+    Pin inpin;
+    int sinkRow;   // row of the sink pins in glbNetSinks, -1 if not set
 
 public:
-    Net(int netID) : id(netID), clock(false), inpin(nullptr) {} // 默认构造函数
+    Net(int netID) : id(netID), clock(false), sinkRow(-1) {} // 默认构造函数
     ~Net() {} // 析构函数
 
     // Getter and setter for id
     int getId() const { return id; }
+    void setId(int value) { id = value; }   // only while renumbering
+    std::string getNetName() const { return "net_" + std::to_string(glbNetIDs.toExternal(id)); }
 
     // Getter and setter for clock
     bool isClock() const { return clock; }
     void setClock(bool value) { clock = value; }
 
     // as named, is this net fanin and all fanouts are in the same tile
+    template <typename View>
+    bool isIntraTileNet(const View& view);
     bool isIntraTileNet(bool isBaseline); 
     
     // Getter and setter for inpin
-    Pin* getInpin() const { return inpin; }
-    void setInpin(Pin* pin) { inpin = pin; }
+    Pin getInpin() const { return inpin; }   // invalid if the net has no driver
+    void setInpin(Pin pin) { inpin = pin; }
 
-    // Getter and setter for outputPins
-    std::list<Pin*> getOutputPins() const { return outputPins; }
-    void addOutputPin(Pin* pin) { outputPins.push_back(pin); }
+    // Getter and setter for the sink pins
+    PinRange getOutputPins() const {
+        return sinkRow < 0 ? PinRange() : PinRange(glbNetSinks.rowBegin(sinkRow), glbNetSinks.rowEnd(sinkRow));
+    }
+    void setSinkRow(int row) { sinkRow = row; }
 
     int getNumPins();
 
-    bool addConnection(std::string conn);
-
+    template <typename View>
+    int getCritWireLength(const View& view);
     int getCritWireLength(bool isBaseline);    
+    template <typename View>
+    void getMergedNonCritPinLocs(const View& view, std::vector<int>& xCoords, std::vector<int>& yCoords);
     void getMergedNonCritPinLocs(bool isBaseline, std::vector<int>& xCoords, std::vector<int>& yCoords);  
     int getNonCritWireLength(bool isBaseline);       
 
@@ -0,0 +1,226 @@
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cstdint>
+#include "outputbin.h"
+#include "netlist.h"
+#include "global.h"
+#include "util.h"
+#include "fileio.h"
+
+// File layout, native byte order:
+//   OutputBinHeader
+//   OutputBinRecord    [numInsts], one per placed instance, in any order
+// The model of each instance is not stored, it is taken from the lib
+// the instance was created with by read_design.
+#define OUTPUT_BIN_MAGIC 0x4C503854   // "T8PL"
+#define OUTPUT_BIN_VERSION 1
+
+struct OutputBinHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t numInsts;
+  uint32_t reserved;
+};
+
+struct OutputBinRecord {
+  int32_t instID;
+  int32_t x;
+  int32_t y;
+  int32_t z;
+};
+
+static bool isOutputBin(const InputFile& file) {
+  uint32_t magic = 0;
+  if (file.getSize() < sizeof(OutputBinHeader)) {
+    return false;
+  }
+  std::memcpy(&magic, file.begin(), sizeof(magic));
+  return magic == OUTPUT_BIN_MAGIC;
+}
+
+// records of a binary placement file, false if the file is not valid
+static bool loadOutputBin(const InputFile& file, const std::string& fileName, std::vector<OutputBinRecord>& records) {
+  OutputBinHeader header;
+  if (!isOutputBin(file)) {
+    std::cout << "Invalid binary placement file: " << fileName << std::endl;
+    return false;
+  }
+  std::memcpy(&header, file.begin(), sizeof(header));
+  if (header.version != OUTPUT_BIN_VERSION) {
+    std::cout << "Unsupported binary placement version " << header.version << ", expected " << OUTPUT_BIN_VERSION << std::endl;
+    return false;
+  }
+  size_t numBytes = (size_t)header.numInsts * sizeof(OutputBinRecord);
+  if (file.getSize() - sizeof(header) < numBytes) {
+    std::cout << "Truncated binary placement file: " << fileName << std::endl;
+    return false;
+  }
+  records.resize(header.numInsts);
+  std::memcpy(records.data(), file.begin() + sizeof(header), numBytes);
+  return true;
+}
+
+// records of a text placement file, the model column is not kept
+static bool loadOutputText(const InputFile& file, std::vector<OutputBinRecord>& records) {
+  LineScanner scanner(file.begin(), file.end());
+  const char* lineBegin;
+  const char* lineEnd;
+  int errCnt = 0;
+  while (scanner.nextLine(lineBegin, lineEnd)) {
+    if (lineBegin == lineEnd || lineBegin[0] == '#') {
+      continue;
+    }
+    Token tokens[3];
+    int numTokens = tokenizeLine(lineBegin, lineEnd, tokens, 3);
+    if (numTokens == 0) {
+      continue;
+    }
+    if (numTokens < 3) {
+      std::cout << "Error, Invalid format of " << std::string(lineBegin, lineEnd) << std::endl;
+      errCnt++;
+      continue;
+    }
+    OutputBinRecord rec;
+    int instID = -1;
+    int x, y, z;
+    if (!parseNameID(tokens[2], instID)) {
+      std::cout << "Error, Invalid name format: " << tokens[2].str() << std::endl;
+      errCnt++;
+      continue;
+    }
+    if (!parseLocation(tokens[0], x, y, z)) {
+      std::cout << "Error, Invalid location format: " << tokens[0].str() << std::endl;
+      errCnt++;
+      continue;
+    }
+    rec.instID = instID;
+    rec.x = x;
+    rec.y = y;
+    rec.z = z;
+    records.push_back(rec);
+  }
+  return errCnt == 0;
+}
+
+static bool writeOutputBin(const std::string& fileName, const std::vector<OutputBinRecord>& records) {
+  std::ofstream outFile(fileName, std::ios::binary);
+  if (!outFile.is_open()) {
+    std::cout << "Failed to open file: " << fileName << std::endl;
+    return false;
+  }
+  OutputBinHeader header;
+  header.magic = OUTPUT_BIN_MAGIC;
+  header.version = OUTPUT_BIN_VERSION;
+  header.numInsts = records.size();
+  header.reserved = 0;
+  outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  outFile.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(OutputBinRecord));
+  outFile.close();
+  if (!outFile) {
+    std::cout << "Failed to write file: " << fileName << std::endl;
+    return false;
+  }
+  return true;
+}
+
+static bool writeOutputText(const std::string& fileName, const std::vector<OutputBinRecord>& records) {
+  std::ofstream outFile(fileName);
+  if (!outFile.is_open()) {
+    std::cout << "Failed to open file: " << fileName << std::endl;
+    return false;
+  }
+  for (const OutputBinRecord& rec : records) {
+    auto instIt = glbInstMap.find(glbInstIDs.toInternal(rec.instID));
+    if (instIt == glbInstMap.end()) {
+      std::cout << "Error, Instance with name inst_" << rec.instID << " can not be indexed." << std::endl;
+      return false;
+    }
+    outFile << "X" << rec.x << "Y" << rec.y << "Z" << rec.z << " "
+            << instIt->second->getCellLib()->getName() << " inst_" << rec.instID << "\n";
+  }
+  outFile.close();
+  if (!outFile) {
+    std::cout << "Failed to write file: " << fileName << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool readOutputBin(const std::string& fileName) {
+  InputFile inputFile;
+  if (!inputFile.open(fileName)) {
+    std::cout << "Failed to open file: " << fileName << std::endl;
+    return false;
+  }
+  auto startTime = std::chrono::steady_clock::now();
+
+  std::vector<OutputBinRecord> records;
+  if (!loadOutputBin(inputFile, fileName, records)) {
+    return false;
+  }
+
+  // clear existing optimized instances in all tiles 
+  for (int tileIdx = 0; tileIdx < chip.getNumTiles(); tileIdx++) {
+    chip.getTileByIndex(tileIdx)->clearOptimizedInstances();   
+  }
+
+  int errCnt = 0;
+  for (const OutputBinRecord& rec : records) {
+    int instID = glbInstIDs.toInternal(rec.instID);
+    auto instIt = glbInstMap.find(instID);
+    if (instIt == glbInstMap.end()) {
+      std::cout << "Error, Instance with name inst_" << rec.instID << " can not be indexed." << std::endl;
+      errCnt++;
+      continue;
+    }
+    if (rec.x < 0 || rec.x >= chip.getNumCol() || rec.y < 0 || rec.y >= chip.getNumRow() || rec.z < 0) {
+      std::cout << "Error, Invalid location X" << rec.x << "Y" << rec.y << "Z" << rec.z
+                << " of instance inst_" << rec.instID << std::endl;
+      errCnt++;
+      continue;
+    }
+    Instance* instance = instIt->second;
+    instance->setLocation(std::make_tuple(rec.x, rec.y, rec.z));
+    Tile* tilePtr = chip.getTile(rec.x, rec.y);
+    if (tilePtr->addInstance(instID, rec.z, instance->getCellLib(), false) == false) {
+      std::cout << "Error: Failed to add optimized coordinate for instance inst_" << rec.instID << std::endl;
+      return false;
+    }
+  }
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+  reportThroughput(fileName, inputFile.getSize(), elapsed.count());
+  inputFile.reportBandwidth();
+  inputFile.close();
+
+  errCnt += reportPlacementStatistics();
+
+  if (errCnt > 0) {
+    return false;
+  } else {
+    return true;
+  }
+}
+
+bool convertOutput(const std::string& inFileName, const std::string& outFileName) {
+  InputFile inputFile;
+  if (!inputFile.open(inFileName)) {
+    std::cout << "Failed to open file: " << inFileName << std::endl;
+    return false;
+  }
+
+  std::vector<OutputBinRecord> records;
+  if (isOutputBin(inputFile)) {
+    if (!loadOutputBin(inputFile, inFileName, records) || !writeOutputText(outFileName, records)) {
+      return false;
+    }
+    std::cout << "  Converted " << records.size() << " instances to text placement " << outFileName << std::endl;
+  } else {
+    if (!loadOutputText(inputFile, records) || !writeOutputBin(outFileName, records)) {
+      return false;
+    }
+    std::cout << "  Converted " << records.size() << " instances to binary placement " << outFileName << std::endl;
+  }
+  return true;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+
+// binary form of a .nodes.out placement:
+// a header followed by a packed array of (instID, x, y, z)
+bool readOutputBin(const std::string& fileName);
+
+// translate a placement between the text and the binary form,
+// the direction is taken from the content of the input file;
+// binary to text needs the design loaded to name the model of each instance
+bool convertOutput(const std::string& inFileName, const std::string& outFileName);
@@ -8,22 +8,17 @@ bool reportPinDensity() {
 
   // 1) baseline
   std::multimap<double, Tile*> baselinePinDensityMap;  
-  for (int i = 0; i < chip.getNumCol(); i++) {
-      for (int j = 0; j < chip.getNumRow(); j++) {
-          Tile* tile = chip.getTile(i, j);
-          if (tile->matchType("PLB") == false) {
-              continue;        
-          }
-          if (tile->isEmpty(true)) {  // baseline
-            continue;
-          }
+  for (int tileIdx : chip.getTilesOfType(TILE_PLB)) {
+    Tile* tile = chip.getTileByIndex(tileIdx);
+    if (tile->isEmpty(true)) {  // baseline
+      continue;
+    }
 
-          // baseline
-          int numInterTileConn = tile->getConnectedLutSeqInput(true).size() + tile->getConnectedLutSeqOutput(true).size();          
-          double ratio = (double)(numInterTileConn) / (MAX_TILE_PIN_INPUT_COUNT + MAX_TILE_PIN_OUTPUT_COUNT);
-          baselinePinDensityMap.insert(std::pair<double, Tile*>(ratio, tile));            
-          checkedTileCnt++;
-      }
+    // baseline
+    int numInterTileConn = tile->getConnectedLutSeqInput(true).size() + tile->getConnectedLutSeqOutput(true).size();          
+    double ratio = (double)(numInterTileConn) / (MAX_TILE_PIN_INPUT_COUNT + MAX_TILE_PIN_OUTPUT_COUNT);
+    baselinePinDensityMap.insert(std::pair<double, Tile*>(ratio, tile));            
+    checkedTileCnt++;
   }
   const int top5Pct = checkedTileCnt * 0.05;
 
@@ -70,22 +65,17 @@ bool reportPinDensity() {
   // 2) optimized
   checkedTileCnt = 0;
   std::multimap<double, Tile*> optimizedPinDensityMap;
-    for (int i = 0; i < chip.getNumCol(); i++) {
-      for (int j = 0; j < chip.getNumRow(); j++) {
-          Tile* tile = chip.getTile(i, j);
-          if (tile->matchType("PLB") == false) {
-              continue;        
-          }
-          if (tile->isEmpty(false)) {  // optimized
-            continue;
-          }
+  for (int tileIdx : chip.getTilesOfType(TILE_PLB)) {
+    Tile* tile = chip.getTileByIndex(tileIdx);
+    if (tile->isEmpty(false)) {  // optimized
+      continue;
+    }
 
-          // optimized
-          int numInterTileConn = tile->getConnectedLutSeqInput(false).size() + tile->getConnectedLutSeqOutput(false).size();          
-          double ratio = (double)(numInterTileConn) / (MAX_TILE_PIN_INPUT_COUNT + MAX_TILE_PIN_OUTPUT_COUNT);
-          optimizedPinDensityMap.insert(std::pair<double, Tile*>(ratio, tile));                      
-          checkedTileCnt++;
-      }
+    // optimized
+    int numInterTileConn = tile->getConnectedLutSeqInput(false).size() + tile->getConnectedLutSeqOutput(false).size();          
+    double ratio = (double)(numInterTileConn) / (MAX_TILE_PIN_INPUT_COUNT + MAX_TILE_PIN_OUTPUT_COUNT);
+    optimizedPinDensityMap.insert(std::pair<double, Tile*>(ratio, tile));                      
+    checkedTileCnt++;
   }
   std::cout << "  Optimized: " << std::endl;
   std::cout << "    Checked pin density on " << checkedTileCnt <<" tiles." << std::endl;
@@ -0,0 +1,166 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include "renumber.h"
+#include "global.h"
+#include "object.h"
+
+// instances get new internal IDs along a space-filling curve over their
+// optimized placement and nets follow the position of their driver, so that
+// the ID-indexed stores hold the objects of a tile and its neighbours close
+// together. glbInstIDs and glbNetIDs keep the IDs of the files, which all
+// names, reports and written files use
+
+#define UNPLACED_KEY INT64_MAX   // sorts unplaced objects last
+
+// position of (x, y) along the Hilbert curve filling a size x size grid,
+// size being a power of two
+static int64_t hilbertIndex(int size, int x, int y) {
+  int64_t index = 0;
+  for (int s = size / 2; s > 0; s /= 2) {
+    int rx = (x & s) > 0;
+    int ry = (y & s) > 0;
+    index += (int64_t)s * s * ((3 * rx) ^ ry);
+    // rotate the quadrant
+    if (ry == 0) {
+      if (rx == 1) {
+        x = s - 1 - x;
+        y = s - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return index;
+}
+
+static int64_t placementKey(int curveSize, int instID) {
+  int x = glbOptimizedPlacement.getX(instID);
+  int y = glbOptimizedPlacement.getY(instID);
+  if (x < 0 || y < 0) {
+    return UNPLACED_KEY;
+  }
+  return hilbertIndex(curveSize, x, y);
+}
+
+// new ID of each object in the order of its key, -1 for unused IDs;
+// equal keys keep the current ID order
+template <typename Key>
+static std::vector<int> assignIDs(std::vector<std::pair<Key, int> >& order) {
+  std::stable_sort(order.begin(), order.end(),
+    [](const std::pair<Key, int>& a, const std::pair<Key, int>& b) {
+      return a.first < b.first;
+    });
+  int maxID = -1;
+  for (const auto& entry : order) {
+    maxID = std::max(maxID, entry.second);
+  }
+  std::vector<int> newIDs(maxID + 1, -1);
+  for (unsigned int i = 0; i < order.size(); i++) {
+    newIDs[order[i].second] = i;
+  }
+  return newIDs;
+}
+
+void renumberDesign() {
+  int curveSize = 1;
+  while (curveSize < chip.getNumCol() || curveSize < chip.getNumRow()) {
+    curveSize *= 2;
+  }
+
+  // instances along the curve, by slot inside a tile
+  std::vector<std::pair<std::pair<int64_t, int>, int> > instOrder;
+  instOrder.reserve(glbInstMap.size());
+  for (const auto& pair : glbInstMap) {
+    int64_t key = placementKey(curveSize, pair.first);
+    int z = key == UNPLACED_KEY ? 0 : glbOptimizedPlacement.getZ(pair.first);
+    instOrder.push_back(std::make_pair(std::make_pair(key, z), pair.first));
+  }
+  std::vector<int> newInstIDs = assignIDs(instOrder);
+
+  // nets by the position of their driver
+  std::vector<std::pair<int64_t, int> > netOrder;
+  netOrder.reserve(glbNetMap.size());
+  for (const auto& pair : glbNetMap) {
+    Pin driver = pair.second->getInpin();
+    int64_t key = driver.isValid() ? placementKey(curveSize, driver.getOwnerID()) : UNPLACED_KEY;
+    netOrder.push_back(std::make_pair(key, pair.first));
+  }
+  std::vector<int> newNetIDs = assignIDs(netOrder);
+
+  // pins follow their instances
+  PinStore pins;
+  std::vector<int> newPinIndex(glbPinStore.size(), -1);
+  ObjectArena<Instance> instArena;
+  IdTable<Instance> instMap;
+  instMap.reserve(instOrder.size());
+  for (const auto& entry : instOrder) {
+    const Instance* inst = glbInstMap.get(entry.second);
+    int first = inst->getPinBegin();
+    int numPins = inst->getNumInpins() + inst->getNumOutpins();
+    int newFirst = pins.copyPins(glbPinStore, first, numPins);
+    for (int i = 0; i < numPins; i++) {
+      newPinIndex[first + i] = newFirst + i;
+    }
+    Instance* newInst = instArena.create(*inst);
+    newInst->setId(newInstIDs[entry.second]);
+    newInst->setPinBegin(newFirst);
+    instMap[newInst->getId()] = newInst;
+  }
+  pins.renumber(newInstIDs, newNetIDs);
+
+  NetSinkStore sinks;
+  sinks.reserve(netOrder.size(), glbPinStore.size());
+  ObjectArena<Net> netArena;
+  IdTable<Net> netMap;
+  netMap.reserve(netOrder.size());
+  std::vector<Pin> rowPins;
+  for (const auto& entry : netOrder) {
+    const Net* net = glbNetMap.get(entry.second);
+    Net* newNet = netArena.create(*net);
+    newNet->setId(newNetIDs[entry.second]);
+    Pin driver = net->getInpin();
+    if (driver.isValid()) {
+      newNet->setInpin(Pin(newPinIndex[driver.getIndex()]));
+    }
+    PinRange sinkPins = net->getOutputPins();
+    if (sinkPins.empty()) {
+      newNet->setSinkRow(-1);
+    } else {
+      rowPins.clear();
+      for (const Pin& pin : sinkPins) {
+        rowPins.push_back(Pin(newPinIndex[pin.getIndex()]));
+      }
+      newNet->setSinkRow(sinks.addRow(rowPins.data(), rowPins.data() + rowPins.size()));
+    }
+    netMap[newNet->getId()] = newNet;
+  }
+
+  // everything else holding an instance or net ID
+  glbBaselinePlacement.renumber(newInstIDs, instOrder.size());
+  glbOptimizedPlacement.renumber(newInstIDs, instOrder.size());
+  for (int tileIdx = 0; tileIdx < chip.getNumTiles(); tileIdx++) {
+    chip.getTileByIndex(tileIdx)->renumberInstances(newInstIDs);
+  }
+  // clock nets of the regions are collected again by the next check
+  for (int i = 0; i < chip.getNumClockCol(); i++) {
+    for (int j = 0; j < chip.getNumClockRow(); j++) {
+      chip.getClockRegion(i, j)->clearClockNets();
+    }
+  }
+  glbInstIDs.renumber(newInstIDs, instOrder.size());
+  glbNetIDs.renumber(newNetIDs, netOrder.size());
+
+  // the old objects go with their arenas
+  glbInstMap = std::move(instMap);
+  glbNetMap = std::move(netMap);
+  glbPinStore = std::move(pins);
+  glbNetSinks = std::move(sinks);
+  glbInstArena.clear();
+  glbInstArena.splice(instArena);
+  glbNetArena.clear();
+  glbNetArena.splice(netArena);
+
+  std::cout << "  Renumbered " << instOrder.size() << " instances and " << netOrder.size() << " nets." << std::endl;
+}
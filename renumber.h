@@ -0,0 +1,5 @@
+#pragma once
+
+// give instances and nets new internal IDs in the order of their optimized
+// placement; names and files keep the original IDs
+void renumberDesign();
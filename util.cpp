@@ -1,4 +1,7 @@
 #include <iostream>
+#include <atomic>
+#include <thread>
+#include <vector>
 #include "util.h"
 
 std::string unifyModelType(std::string inputType) {
@@ -9,4 +12,32 @@ std::string unifyModelType(std::string inputType) {
         trimmedType = subType;
     } 
     return trimmedType;
-}
\ No newline at end of file
+}
+
+void runParallel(int numTasks, int numThreads, const std::function<void(int)>& task) {
+    if (numThreads > numTasks) {
+        numThreads = numTasks;
+    }
+    if (numThreads <= 1) {
+        for (int i = 0; i < numTasks; i++) {
+            task(i);
+        }
+        return;
+    }
+
+    // tasks are picked up in order by whichever thread is free
+    std::atomic<int> nextTask(0);
+    auto worker = [&]() {
+        for (int i = nextTask++; i < numTasks; i = nextTask++) {
+            task(i);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int i = 1; i < numThreads; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
@@ -1,5 +1,94 @@
-
 #pragma once
 
+#include <string>
+#include <cstring>
+#include <functional>
+
 // unitfy lut1-6 as lut
-std::string unifyModelType(std::string inputType);
\ No newline at end of file
+std::string unifyModelType(std::string inputType);
+
+// run task(0) ... task(numTasks - 1) on up to numThreads threads
+void runParallel(int numTasks, int numThreads, const std::function<void(int)>& task);
+
+// non-owning view of a token inside a line buffer
+struct Token {
+    const char* begin;
+    const char* end;
+
+    size_t size() const { return end - begin; }
+    std::string str() const { return std::string(begin, end); }
+    bool equals(const char* s, size_t len) const { return size() == len && std::memcmp(begin, s, len) == 0; }
+    bool equals(const char* s) const { return equals(s, std::strlen(s)); }
+    bool equals(const std::string& s) const { return equals(s.data(), s.size()); }
+};
+
+// same set of separators as operator>> on a std::istream
+inline bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f' || c == '\n';
+}
+
+// split [begin, end) on blanks; at most maxTokens tokens are stored,
+// the total number of tokens on the line is returned
+inline int tokenizeLine(const char* begin, const char* end, Token* tokens, int maxTokens) {
+    int numTokens = 0;
+    const char* p = begin;
+    while (true) {
+        while (p < end && isBlank(*p)) {
+            p++;
+        }
+        if (p == end) {
+            break;
+        }
+        const char* tokBegin = p;
+        while (p < end && !isBlank(*p)) {
+            p++;
+        }
+        if (numTokens < maxTokens) {
+            tokens[numTokens].begin = tokBegin;
+            tokens[numTokens].end = p;
+        }
+        numTokens++;
+    }
+    return numTokens;
+}
+
+// parse a run of decimal digits starting at p, p is advanced past the digits
+inline bool parseDigits(const char*& p, const char* end, int& value) {
+    const char* start = p;
+    int v = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        v = v * 10 + (*p - '0');
+        p++;
+    }
+    if (p == start) {
+        return false;
+    }
+    value = v;
+    return true;
+}
+
+// extract the ID from names like inst_12 or net_7
+inline bool parseNameID(const Token& name, int& id) {
+    const char* p = static_cast<const char*>(std::memchr(name.begin, '_', name.size()));
+    if (p == nullptr) {
+        return false;
+    }
+    p++;
+    return parseDigits(p, name.end, id);
+}
+
+// find the first X<col>Y<row>Z<offset> pattern in the token
+inline bool parseLocation(const Token& loc, int& x, int& y, int& z) {
+    for (const char* start = loc.begin; start < loc.end; start++) {
+        if (*start != 'X') {
+            continue;
+        }
+        const char* p = start + 1;
+        if (parseDigits(p, loc.end, x) && p < loc.end && *p++ == 'Y' &&
+            parseDigits(p, loc.end, y) && p < loc.end && *p++ == 'Z' &&
+            parseDigits(p, loc.end, z)) {
+            return true;
+        }
+    }
+    return false;
+}